@@ -0,0 +1,241 @@
+#include "GameProject.hpp"
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+// ALLOCATION COUNTING
+// Global operator new is replaced so every heap allocation in the process
+// bumps a counter; the game loop reads the per-thread one once per frame.
+// Box2D allocates through its own hook, which is counted the same way.
+
+static std::atomic<uint64_t> g_allocs{ 0 };
+static thread_local uint64_t t_allocs = 0;
+
+uint64_t threadAllocationCount()
+{
+    return t_allocs;
+}
+
+static void* countedAlloc(std::size_t size)
+{
+    g_allocs.fetch_add(1, std::memory_order_relaxed);
+    ++t_allocs;
+    return std::malloc(size ? size : 1);
+}
+
+static void* countedAlignedAlloc(std::size_t size, std::size_t align)
+{
+    g_allocs.fetch_add(1, std::memory_order_relaxed);
+    ++t_allocs;
+#ifdef _MSC_VER
+    return _aligned_malloc(size ? size : 1, align);
+#else
+    size = ((size ? size : 1) + align - 1) / align * align;
+    return std::aligned_alloc(align, size);
+#endif
+}
+
+static void alignedFree(void* p)
+{
+#ifdef _MSC_VER
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+void* operator new(std::size_t size)
+{
+    if (void* p = countedAlloc(size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    if (void* p = countedAlloc(size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return countedAlloc(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return countedAlloc(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t align)
+{
+    if (void* p = countedAlignedAlloc(size, (std::size_t)align))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t align)
+{
+    if (void* p = countedAlignedAlloc(size, (std::size_t)align))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { alignedFree(p); }
+
+// sizes arrive rounded up to the alignment (32), as aligned_alloc wants
+static void* box2dAlloc(unsigned int size, int alignment)
+{
+    return countedAlignedAlloc(size, (std::size_t)alignment);
+}
+
+static void box2dFree(void* mem)
+{
+    alignedFree(mem);
+}
+
+void countBox2DAllocations()
+{
+    b2SetAllocator(box2dAlloc, box2dFree);
+}
+
+// prints at most once a second (60 frames), and only if something allocated
+void trackFrameAllocs(AllocReport& report)
+{
+    uint64_t now = threadAllocationCount();
+    uint64_t allocs = now - report.last;
+    if (++report.frames > ALLOC_WARMUP_FRAMES && allocs > 0)
+    {
+        ++report.badFrames;
+        report.total += allocs;
+    }
+    if (report.frames % 60 == 0 && report.badFrames > 0)
+    {
+        std::cout << "alloc (" << report.label << "): " << report.badFrames
+            << " of the last 60 frames allocated (" << report.total << " allocations)\n";
+        report.badFrames = 0;
+        report.total = 0;
+    }
+    report.last = threadAllocationCount();
+}
+
+// FRAME ARENA
+// Bump allocator for temporaries that die at the end of the frame.
+
+void initFrameArena(FrameArena& arena, size_t capacity)
+{
+    arena.memory.reset(new unsigned char[capacity]);
+    arena.capacity = capacity;
+    arena.used = 0;
+}
+
+void resetFrameArena(FrameArena& arena)
+{
+    arena.used = 0;
+}
+
+void* frameAlloc(FrameArena& arena, size_t size, size_t align)
+{
+    size_t start = (arena.used + align - 1) & ~(align - 1);
+    if (start + size > arena.capacity)
+    {
+        std::cout << "Frame arena out of memory (" << arena.capacity << " bytes)\n";
+        return nullptr;
+    }
+    arena.used = start + size;
+    return arena.memory.get() + start;
+}
+
+// printf into frame memory; the string is valid until the next reset
+const char* frameFormat(FrameArena& arena, const char* fmt, ...)
+{
+    char* buf = static_cast<char*>(frameAlloc(arena, 64, 1));
+    if (!buf)
+        return "";
+
+    va_list args;
+    va_start(args, fmt);
+    int n = std::vsnprintf(buf, 64, fmt, args);
+    va_end(args);
+
+    // give back what the string didn't use
+    if (n >= 0 && n < 63)
+        arena.used -= 63 - n;
+    return buf;
+}
+
+// HEADLESS CHECK
+// Runs what the game's sim thread runs every tick: a bot arena stepped as
+// a job graph on a started worker pool (Box2D's allocations included), the
+// render snapshot build, and the HUD and stats-overlay number formatting.
+// Fails if any tick after warm-up touched the heap on any thread. The
+// render thread's draw calls need a window and are not covered here.
+
+int runAllocCheck(int frames)
+{
+    WorkerPool pool;
+    int threads = std::max(2, (int)std::thread::hardware_concurrency() - 2);
+    startWorkerPool(pool, threads);
+
+    Arena arena;
+    setupArena(arena, 1234u);
+    arena.pool = &pool;
+
+    FrameArena frame;
+    initFrameArena(frame, 64 * 1024);
+    RenderSnapshot snap;
+    RenderStats stats;
+
+    int badFrames = 0;
+    uint64_t worst = 0;
+    for (int i = 0; i < ALLOC_WARMUP_FRAMES + frames; ++i)
+    {
+        // workers allocate into the global count, not this thread's
+        uint64_t before = g_allocs.load(std::memory_order_relaxed);
+
+        resetFrameArena(frame);
+        stepArena(arena, botInput(arena));
+        if (arena.gameOver || arena.playerWon)
+            resetArena(arena, MAX_ENEMIES, 0);
+        buildRenderSnapshot(arena, snap);
+
+        // HUD numbers, then the overlay's table of counts
+        frameFormat(frame, "%d", snap.score);
+        frameFormat(frame, "%d", snap.highScore);
+        beginRenderStats(stats);
+        for (const DrawCounts& d : stats.last)
+        {
+            frameFormat(frame, "%u", d.draws);
+            frameFormat(frame, "%u", d.vertices);
+            frameFormat(frame, "%u", d.textureBinds);
+            frameFormat(frame, "%u", d.stateChanges);
+        }
+
+        uint64_t allocs = g_allocs.load(std::memory_order_relaxed) - before;
+        if (i >= ALLOC_WARMUP_FRAMES && allocs > 0)
+        {
+            ++badFrames;
+            worst = std::max(worst, allocs);
+        }
+    }
+
+    uint64_t pooled = pool.pooledRuns;
+    stopWorkerPool(pool);
+    destroyArena(arena);
+
+    std::cout << "alloc check: " << badFrames << " of " << frames
+        << " frames allocated (worst " << worst << "), "
+        << threads << " threads, " << pooled << " waves on the pool\n";
+    return badFrames == 0 ? 0 : 1;
+}
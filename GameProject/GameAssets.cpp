@@ -0,0 +1,266 @@
+#include "GameProject.hpp"
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// ARCHIVE LAYOUT (little endian)
+//   header   "BBSPAK01", u32 version, u32 entry count, u64 reserved
+//   toc      entries sorted by name so lookups can binary search
+//   data     every asset starts on an ASSET_ALIGN boundary
+
+constexpr char     ASSET_MAGIC[8] = { 'B', 'B', 'S', 'P', 'A', 'K', '0', '1' };
+constexpr uint32_t ASSET_VERSION = 1;
+constexpr uint64_t ASSET_ALIGN = 64;
+
+struct AssetHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t count;
+    uint64_t reserved;
+};
+
+static const AssetEntry* assetToc(const AssetArchive& pak)
+{
+    return reinterpret_cast<const AssetEntry*>(pak.data + sizeof(AssetHeader));
+}
+
+static void unmapArchive(AssetArchive& pak)
+{
+#ifdef _WIN32
+    if (pak.data) UnmapViewOfFile(pak.data);
+    if (pak.mapping) CloseHandle(pak.mapping);
+    if (pak.file) CloseHandle(pak.file);
+    pak.mapping = nullptr;
+    pak.file = nullptr;
+#else
+    if (pak.data) munmap(const_cast<unsigned char*>(pak.data), pak.size);
+#endif
+    pak.data = nullptr;
+    pak.size = 0;
+    pak.count = 0;
+}
+
+// one open + one mapping for every asset in the game
+bool openAssetArchive(AssetArchive& pak, const char* path)
+{
+#ifdef _WIN32
+    pak.file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (pak.file == INVALID_HANDLE_VALUE)
+    {
+        pak.file = nullptr;
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    GetFileSizeEx(pak.file, &size);
+    pak.size = (size_t)size.QuadPart;
+
+    pak.mapping = CreateFileMappingA(pak.file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (pak.mapping)
+        pak.data = static_cast<const unsigned char*>(MapViewOfFile(pak.mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    fstat(fd, &st);
+    pak.size = (size_t)st.st_size;
+
+    void* p = mmap(nullptr, pak.size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (p != MAP_FAILED)
+        pak.data = static_cast<const unsigned char*>(p);
+#endif
+
+    if (!pak.data || pak.size < sizeof(AssetHeader))
+    {
+        std::cout << "Failed to map " << path << "\n";
+        unmapArchive(pak);
+        return false;
+    }
+
+    // header + toc sanity, so a truncated file never gets read past its end
+    const AssetHeader* header = reinterpret_cast<const AssetHeader*>(pak.data);
+    bool ok = std::memcmp(header->magic, ASSET_MAGIC, sizeof(ASSET_MAGIC)) == 0 &&
+        header->version == ASSET_VERSION &&
+        sizeof(AssetHeader) + (uint64_t)header->count * sizeof(AssetEntry) <= pak.size;
+    if (ok)
+    {
+        pak.count = header->count;
+        for (uint32_t i = 0; i < pak.count && ok; ++i)
+        {
+            const AssetEntry& e = assetToc(pak)[i];
+            ok = e.offset <= pak.size && e.size <= pak.size - e.offset;
+        }
+    }
+    if (!ok)
+    {
+        std::cout << path << " is not a valid asset archive\n";
+        unmapArchive(pak);
+        return false;
+    }
+
+    return true;
+}
+
+void closeAssetArchive(AssetArchive& pak)
+{
+    unmapArchive(pak);
+}
+
+bool findAsset(const AssetArchive& pak, const char* name, const void*& data, size_t& size)
+{
+    if (!pak.data)
+        return false;
+
+    const AssetEntry* begin = assetToc(pak);
+    const AssetEntry* end = begin + pak.count;
+    const AssetEntry* it = std::lower_bound(begin, end, name,
+        [](const AssetEntry& e, const char* n) { return std::strncmp(e.name, n, sizeof(e.name)) < 0; });
+    if (it == end || std::strncmp(it->name, name, sizeof(it->name)) != 0)
+        return false;
+
+    data = pak.data + it->offset;
+    size = (size_t)it->size;
+    return true;
+}
+
+// in the archive or as a loose file; lets callers probe for optional
+// formats without SFML printing an error for each miss
+bool hasAsset(const AssetArchive& pak, const char* name)
+{
+    const void* data;
+    size_t size;
+    if (findAsset(pak, name, data, size))
+        return true;
+
+    // loose file: metadata only, the loader opens it once afterwards
+#ifdef _WIN32
+    DWORD attributes = GetFileAttributesA(name);
+    return attributes != INVALID_FILE_ATTRIBUTES && !(attributes & FILE_ATTRIBUTE_DIRECTORY);
+#else
+    struct stat st;
+    return stat(name, &st) == 0 && S_ISREG(st.st_mode);
+#endif
+}
+
+// SFML LOADERS: archive first (straight from the mapping), loose file second
+
+bool loadAsset(sf::SoundBuffer& buffer, const AssetArchive& pak, const char* name)
+{
+    const void* data;
+    size_t size;
+    if (findAsset(pak, name, data, size))
+        return buffer.loadFromMemory(data, size);
+    return buffer.loadFromFile(name);
+}
+
+bool loadAsset(sf::Font& font, const AssetArchive& pak, const char* name)
+{
+    const void* data;
+    size_t size;
+    if (findAsset(pak, name, data, size))
+        return font.loadFromMemory(data, size);
+    return font.loadFromFile(std::string("C:\\Windows\\Fonts\\") + name);
+}
+
+bool openAsset(sf::Music& music, const AssetArchive& pak, const char* name)
+{
+    const void* data;
+    size_t size;
+    if (findAsset(pak, name, data, size))
+        return music.openFromMemory(data, size);
+    return music.openFromFile(name);
+}
+
+// PACKER: GameProject.exe --pack assets.pak fire.wav jump.wav ...
+// Entries are stored under their file name without the directory.
+
+int runPacker(const char* outPath, int fileCount, char** files)
+{
+    std::vector<AssetEntry> toc;
+    std::vector<std::vector<char>> blobs;
+
+    for (int i = 0; i < fileCount; ++i)
+    {
+        std::ifstream in(files[i], std::ios::binary);
+        if (!in)
+        {
+            std::cout << "Cannot read " << files[i] << "\n";
+            return 1;
+        }
+        std::vector<char> blob((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+        const char* base = files[i];
+        for (const char* c = files[i]; *c; ++c)
+            if (*c == '/' || *c == '\\') base = c + 1;
+
+        AssetEntry e{};
+        if (std::strlen(base) >= sizeof(e.name))
+        {
+            std::cout << "Name too long: " << base << "\n";
+            return 1;
+        }
+        std::memcpy(e.name, base, std::strlen(base));   // e{} keeps the terminator
+        e.size = blob.size();
+
+        toc.push_back(e);
+        blobs.push_back(std::move(blob));
+    }
+
+    // sort toc (and blobs with it) by name
+    std::vector<int> order(toc.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = (int)i;
+    std::sort(order.begin(), order.end(),
+        [&](int a, int b) { return std::strncmp(toc[a].name, toc[b].name, sizeof(toc[a].name)) < 0; });
+
+    uint64_t offset = sizeof(AssetHeader) + toc.size() * sizeof(AssetEntry);
+    std::vector<AssetEntry> sorted;
+    for (int i : order)
+    {
+        offset = (offset + ASSET_ALIGN - 1) / ASSET_ALIGN * ASSET_ALIGN;
+        AssetEntry e = toc[i];
+        e.offset = offset;
+        offset += e.size;
+        sorted.push_back(e);
+    }
+
+    std::ofstream out(outPath, std::ios::binary);
+    if (!out)
+    {
+        std::cout << "Cannot write " << outPath << "\n";
+        return 1;
+    }
+
+    AssetHeader header{};
+    std::memcpy(header.magic, ASSET_MAGIC, sizeof(ASSET_MAGIC));
+    header.version = ASSET_VERSION;
+    header.count = (uint32_t)sorted.size();
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(sorted.data()), sorted.size() * sizeof(AssetEntry));
+
+    for (size_t k = 0; k < sorted.size(); ++k)
+    {
+        const std::vector<char>& blob = blobs[order[k]];
+        while ((uint64_t)out.tellp() < sorted[k].offset)
+            out.put('\0');
+        out.write(blob.data(), blob.size());
+        std::cout << "  " << sorted[k].name << "  " << blob.size() << " bytes\n";
+    }
+
+    std::cout << "Wrote " << outPath << " (" << sorted.size() << " assets, "
+        << (uint64_t)out.tellp() << " bytes)\n";
+    return out ? 0 : 1;
+}
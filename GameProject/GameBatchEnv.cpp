@@ -0,0 +1,143 @@
+#include "GameProject.hpp"
+
+// one env's slice of the observation buffer
+void writeObservation(const Arena& arena, float* obs)
+{
+    b2Vec2 p = b2Body_GetPosition(arena.player.id);
+    b2Vec2 v = b2Body_GetLinearVelocity(arena.player.id);
+    obs[OBS_PLAYER + 0] = p.x;
+    obs[OBS_PLAYER + 1] = p.y;
+    obs[OBS_PLAYER + 2] = v.x;
+    obs[OBS_PLAYER + 3] = v.y;
+
+    for (int i = 0; i < MAX_ENEMIES; ++i)
+    {
+        float* e = obs + OBS_ENEMY + i * OBS_ENEMY_STRIDE;
+        if (i < (int)arena.enemies.size() && arena.enemies[i].alive)
+        {
+            b2Vec2 ep = b2Body_GetPosition(arena.enemies[i].id);
+            b2Vec2 ev = b2Body_GetLinearVelocity(arena.enemies[i].id);
+            e[0] = ep.x;
+            e[1] = ep.y;
+            e[2] = ev.x;
+            e[3] = ev.y;
+            e[4] = 1.f;
+        }
+        else
+        {
+            std::fill(e, e + OBS_ENEMY_STRIDE, 0.f);
+        }
+    }
+
+    obs[OBS_SCORE] = (float)arena.player.score;
+}
+
+static void batchResetTask(void* ctx, int begin, int end)
+{
+    BatchEnv& env = *static_cast<BatchEnv*>(ctx);
+    for (int i = begin; i < end; ++i)
+    {
+        Arena& arena = *env.arenas[i];
+        resetArena(arena, arena.enemyCap, 0);
+        writeObservation(arena, env.obs + (size_t)i * OBS_SIZE);
+    }
+}
+
+static void batchStepTask(void* ctx, int begin, int end)
+{
+    BatchEnv& env = *static_cast<BatchEnv*>(ctx);
+    for (int i = begin; i < end; ++i)
+    {
+        Arena& arena = *env.arenas[i];
+        uint8_t a = env.actions[i];
+
+        PlayerInput input;
+        input.left = a & 1;
+        input.right = a & 2;
+        input.jump = a & 4;
+        input.shoot = a & 8;
+        stepArena(arena, input);
+
+        // finished rounds restart in place, the caller only sees the flag
+        bool done = arena.gameOver || arena.playerWon;
+        if (done)
+            resetArena(arena, arena.enemyCap, 0);
+
+        env.dones[i] = done ? 1 : 0;
+        writeObservation(arena, env.obs + (size_t)i * OBS_SIZE);
+    }
+}
+
+void createBatchEnv(BatchEnv& env, int envCount, int threadCount, unsigned seed)
+{
+    envCount = std::max(1, envCount);
+    threadCount = std::max(1, threadCount);
+
+    env.arenas.clear();
+    for (int i = 0; i < envCount; ++i)
+    {
+        env.arenas.push_back(std::make_unique<Arena>());
+        setupArena(*env.arenas.back(), seed + (unsigned)i);
+    }
+
+    // a few chunks per thread so uneven envs balance out
+    env.grain = std::max(1, envCount / (threadCount * 4));
+    startWorkerPool(env.pool, threadCount);
+}
+
+void destroyBatchEnv(BatchEnv& env)
+{
+    stopWorkerPool(env.pool);
+    for (auto& a : env.arenas)
+        destroyArena(*a);
+    env.arenas.clear();
+}
+
+void batchReset(BatchEnv& env, float* obs)
+{
+    env.obs = obs;
+    parallelFor(env.pool, (int)env.arenas.size(), env.grain, batchResetTask, &env);
+}
+
+void batchStep(BatchEnv& env, const uint8_t* actions, float* obs, uint8_t* dones)
+{
+    env.actions = actions;
+    env.obs = obs;
+    env.dones = dones;
+    parallelFor(env.pool, (int)env.arenas.size(), env.grain, batchStepTask, &env);
+}
+
+// random actions, prints env steps per second
+int runBatchBench(int envCount, int threadCount, int steps)
+{
+    BatchEnv env;
+    createBatchEnv(env, envCount, threadCount, 1234u);
+    int n = (int)env.arenas.size();
+
+    std::vector<uint8_t> actions(n);
+    std::vector<float> obs((size_t)n * OBS_SIZE);
+    std::vector<uint8_t> dones(n);
+    batchReset(env, obs.data());
+
+    uint32_t lcg = 12345u;
+    int rounds = 0;
+    sf::Clock clock;
+    for (int s = 0; s < steps; ++s)
+    {
+        for (auto& a : actions)
+        {
+            lcg = lcg * 1664525u + 1013904223u;
+            a = uint8_t(lcg >> 28);
+        }
+        batchStep(env, actions.data(), obs.data(), dones.data());
+        for (uint8_t d : dones)
+            rounds += d;
+    }
+    float seconds = clock.getElapsedTime().asSeconds();
+
+    std::cout << n << " envs x " << steps << " steps on " << threadCount << " threads: "
+        << (double)n * steps / seconds << " steps/s, " << rounds << " rounds finished\n";
+
+    destroyBatchEnv(env);
+    return 0;
+}
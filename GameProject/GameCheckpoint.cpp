@@ -0,0 +1,175 @@
+#include "GameProject.hpp"
+#include <cstdio>
+#include <fstream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+// fflush + fsync: the bytes are on disk, not just in a cache
+bool syncFile(std::FILE* f)
+{
+    if (std::fflush(f) != 0)
+        return false;
+#ifdef _WIN32
+    return _commit(_fileno(f)) == 0;
+#else
+    return fsync(fileno(f)) == 0;
+#endif
+}
+
+// write to "<path>.tmp", flush it to disk, then swap it over the real file,
+// so a crash mid-write leaves the previous file intact
+bool writeFileAtomic(const char* path, const void* data, size_t size)
+{
+    std::string tmpPath = std::string(path) + ".tmp";
+    std::FILE* f = openFile(tmpPath.c_str(), "wb");
+    if (!f)
+        return false;
+
+    bool ok = std::fwrite(data, 1, size, f) == size && syncFile(f);
+    ok = std::fclose(f) == 0 && ok;
+    if (!ok)
+        return false;
+
+#ifdef _WIN32
+    return MoveFileExA(tmpPath.c_str(), path,
+        MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return std::rename(tmpPath.c_str(), path) == 0;
+#endif
+}
+
+static bool writeSaveFile(const std::string& path, const SaveState& state)
+{
+    char text[64];
+    int len = std::snprintf(text, sizeof(text), "%d %d %d",
+        state.resumeScore, state.resumeEnemies, state.highScore);
+    return writeFileAtomic(path.c_str(), text, (size_t)len);
+}
+
+// I/O thread: sleeps until something is queued, then appends finished runs
+// (log first, index second) and writes the newest save. The index is
+// caught up from the log itself, so runs another process appended in the
+// meantime are ranked too, and logBytes is always the real end of the log.
+static void checkpointThreadMain(CheckpointService* cp)
+{
+    std::unique_lock<std::mutex> lock(cp->m);
+    for (;;)
+    {
+        cp->wake.wait(lock, [cp] { return cp->hasPending || !cp->runs.empty() || cp->quit; });
+        if (!cp->hasPending && cp->runs.empty())
+            break;   // quit with nothing left to write
+
+        bool hasSave = cp->hasPending;
+        SaveState state = cp->pending;
+        cp->hasPending = false;
+
+        FixedVector<RunRecord, MAX_QUEUED_RUNS> runs = cp->runs;
+        cp->runs.clear();
+        lock.unlock();
+
+        sf::Clock clock;
+        if (!runs.empty())
+        {
+            bool logged = true;
+            for (const RunRecord& run : runs)
+                logged = appendRun(RUN_LOG, run) && logged;
+
+            // an index that claims more log than exists gets rebuilt on load
+            catchUpLeaderboard(cp->index, RUN_LOG, false);
+            if (!logged || !writeLeaderboardIndex(RUN_INDEX, cp->index))
+                std::cout << "Failed to record run in " << RUN_LOG << "\n";
+        }
+
+        if (hasSave)
+        {
+            if (writeSaveFile(cp->path, state))
+                ++cp->written;
+            else
+                std::cout << "Failed to write " << cp->path << "\n";
+        }
+        cp->slowestWriteMs = std::max(cp->slowestWriteMs, (int)clock.getElapsedTime().asMilliseconds());
+
+        lock.lock();
+    }
+}
+
+void startCheckpoints(CheckpointService& cp, const char* path, const Leaderboard& index)
+{
+    cp.path = path;
+    cp.index = index;
+    cp.quit = false;
+    cp.written = 0;
+    cp.slowestWriteMs = 0;
+    cp.hasPending = false;
+    cp.runs.clear();
+    cp.thread = std::thread(checkpointThreadMain, &cp);
+}
+
+// game thread side: copy a few ints and wake the writer, never touches disk.
+// A newer request replaces one that has not been written yet.
+void requestCheckpoint(CheckpointService& cp, const SaveState& state)
+{
+    {
+        std::lock_guard<std::mutex> lock(cp.m);
+        cp.pending = state;
+        cp.hasPending = true;
+    }
+    cp.wake.notify_one();
+}
+
+// finished run: appended to the log and ranked into the index on the
+// checkpoint thread
+void recordRun(CheckpointService& cp, const RunRecord& run)
+{
+    {
+        std::lock_guard<std::mutex> lock(cp.m);
+        if (!cp.runs.push_back(run))
+        {
+            std::cout << "Run queue full, dropping run\n";
+            return;
+        }
+    }
+    cp.wake.notify_one();
+}
+
+// writes whatever is still queued, then joins
+void stopCheckpoints(CheckpointService& cp)
+{
+    {
+        std::lock_guard<std::mutex> lock(cp.m);
+        cp.quit = true;
+    }
+    cp.wake.notify_one();
+    if (cp.thread.joinable())
+        cp.thread.join();
+
+    if (cp.written > 0)
+        std::cout << "Checkpoints: " << cp.written << " saves written, slowest write "
+            << cp.slowestWriteMs << " ms\n";
+}
+
+bool loadCheckpoint(const char* path, SaveState& state)
+{
+    std::ifstream in(path);
+    if (!in)
+        return false;
+
+    // Try to read 3 values: resumeScore, resumeEnemies, highScore
+    in >> state.resumeScore >> state.resumeEnemies >> state.highScore;
+    if (!in)
+    {
+        // Fallback for old 2-value save files: resumeScore + highScore
+        in.clear();
+        in.seekg(0);
+        in >> state.resumeScore >> state.highScore;
+        state.resumeEnemies = MAX_ENEMIES;
+    }
+    return true;
+}
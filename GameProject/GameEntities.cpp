@@ -11,70 +11,95 @@ void setupPlayer(Player& player, b2WorldId world)
 
     b2ShapeDef sd = b2DefaultShapeDef();
     sd.density = 1.f;
+    sd.filter = collisionFilter(CAT_PLAYER);
     b2Circle c{ {0.f, 0.f}, player.radius };
     b2CreateCircleShape(player.id, &sd, &c);
+}
+
+// One shape per entity kind, built once
+void setupEntityGfx(EntityGfx& gfx)
+{
+    const float playerR = Player{}.radius * PX;
+    PlayerGfx& p = gfx.player;
 
-    player.gfx = sf::CircleShape(player.radius * PX);
-    player.gfx.setOrigin(player.radius * PX, player.radius * PX);
-    player.gfx.setFillColor(sf::Color::Cyan);
-    player.gfx.setOutlineColor(sf::Color::White);
-    player.gfx.setOutlineThickness(4);
+    p.body = sf::CircleShape(playerR);
+    p.body.setOrigin(playerR, playerR);
+    p.body.setFillColor(sf::Color::Cyan);
+    p.body.setOutlineColor(sf::Color::White);
+    p.body.setOutlineThickness(4);
 
     // Gun symbol
-    player.gun.setSize({ player.radius * PX * 1.2f, player.radius * PX * 0.4f });
-    player.gun.setOrigin(
-        player.gun.getSize().x * 0.2f,
-        player.gun.getSize().y / 2.f
+    p.gun.setSize({ playerR * 1.2f, playerR * 0.4f });
+    p.gun.setOrigin(
+        p.gun.getSize().x * 0.2f,
+        p.gun.getSize().y / 2.f
     );
-    player.gun.setFillColor(sf::Color(40, 40, 40));
+    p.gun.setFillColor(sf::Color(40, 40, 40));
 
     // Muzzle flash
-    player.muzzle = sf::CircleShape(player.radius * PX * 0.3f);
-    player.muzzle.setOrigin(player.muzzle.getRadius(), player.muzzle.getRadius());
-    player.muzzle.setFillColor(sf::Color::Yellow);
+    p.muzzle = sf::CircleShape(playerR * 0.3f);
+    p.muzzle.setOrigin(p.muzzle.getRadius(), p.muzzle.getRadius());
+    p.muzzle.setFillColor(sf::Color::Yellow);
+
+    // Enemies (colour is set per enemy when drawing)
+    const float enemyR = Enemy{}.radius * PX;
+    gfx.enemy = sf::CircleShape(enemyR);
+    gfx.enemy.setOrigin(enemyR, enemyR);
+
+    // Bullets
+    gfx.bullet = sf::CircleShape(0.15f * PX);
+    gfx.bullet.setOrigin(0.15f * PX, 0.15f * PX);
+    gfx.bullet.setFillColor(sf::Color::Yellow);
 }
 
 // Enemy spawn 
-void spawnEnemy(std::vector<Enemy>& enemies,
+void spawnEnemy(EnemyList& enemies,
     b2WorldId world,
-    std::mt19937& rng,
-    std::uniform_int_distribution<int>& col,
-    std::uniform_int_distribution<int>& scoreDist,
-    std::uniform_real_distribution<float>& xSpawn,
-    std::uniform_real_distribution<float>& pathTimeDist,
-    std::uniform_real_distribution<float>& jumpCDDist)
+    uint64_t seed,
+    uint32_t uid,
+    int maxEnemies)
 {
-    if ((int)enemies.size() >= MAX_ENEMIES) return;
+    if ((int)enemies.size() >= maxEnemies || enemies.full()) return;
+
+    RandomBlock r = philox(seed, uid, 0, RNG_SPAWN, 0);
+    RandomBlock r2 = philox(seed, uid, 0, RNG_SPAWN, 1);
 
     Enemy e;
+    e.uid = uid;
     b2BodyDef bd = b2DefaultBodyDef();
     bd.type = b2_dynamicBody;
-    bd.position = { xSpawn(rng), WORLD_CEIL - 0.5f };
+    bd.position = { randomRange(r.v[0], WORLD_LEFT + 1.f, WORLD_RIGHT - 1.f), WORLD_CEIL - 0.5f };
     e.id = b2CreateBody(world, &bd);
 
     b2ShapeDef sd = b2DefaultShapeDef();
     sd.density = 1.f;
+    sd.filter = collisionFilter(CAT_ENEMY);
     b2Circle c{ {0.f, 0.f}, e.radius };
     b2CreateCircleShape(e.id, &sd, &c);
 
-    e.gfx = sf::CircleShape(e.radius * PX);
-    e.gfx.setOrigin(e.radius * PX, e.radius * PX);
-    e.gfx.setFillColor(sf::Color(col(rng), col(rng) / 2, col(rng)));
-    e.scoreValue = scoreDist(rng);
+    // colour channels 100-255 (green halved), score 5-20
+    uint32_t bits = r.v[1];
+    e.color = sf::Color(
+        100 + (bits & 0xFF) % 156,
+        (100 + (bits >> 8 & 0xFF) % 156) / 2,
+        100 + (bits >> 16 & 0xFF) % 156);
+    e.scoreValue = 5 + (int)(r.v[2] % 16);
     e.alive = true;
-    e.sideBias = (rng() % 2 == 0) ? -1.f : 1.f;
-    e.pathTimer = pathTimeDist(rng);
-    e.jumpCooldown = jumpCDDist(rng);
+    e.sideBias = (r.v[3] & 1) ? 1.f : -1.f;
+    e.pathTimer = randomRange(r2.v[0], 1.f, 3.f);
+    e.jumpCooldown = randomRange(r2.v[1], 0.8f, 1.8f);
 
     enemies.push_back(e);
 }
 
 // Bullet shoot 
-void shoot(std::deque<Bullet>& bullets,
+void shoot(BulletList& bullets,
     Player& player,
     float dir,
     b2WorldId world)
 {
+    if (bullets.full()) return;
+
     Bullet b;
 
     b2BodyDef bd = b2DefaultBodyDef();
@@ -88,15 +113,12 @@ void shoot(std::deque<Bullet>& bullets,
 
     b2ShapeDef sd = b2DefaultShapeDef();
     sd.density = 0.2f;
+    sd.filter = collisionFilter(CAT_BULLET);
     b2Circle c{ {0.f, 0.f}, 0.15f };
     b2CreateCircleShape(b.id, &sd, &c);
 
     b2Body_SetLinearVelocity(b.id, { dir * 15.f, 2.f });
 
-    b.gfx = sf::CircleShape(0.15f * PX);
-    b.gfx.setOrigin(0.15f * PX, 0.15f * PX);
-    b.gfx.setFillColor(sf::Color::Yellow);
-
     bullets.push_back(b);
 
     // show muzzle flash briefly  
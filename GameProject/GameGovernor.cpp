@@ -0,0 +1,141 @@
+#include "GameProject.hpp"
+
+// Two ladders, cheapest-looking cut first. The simulation ladder trades
+// physics accuracy and AI reaction time, the render ladder trades circle
+// smoothness and world resolution. Level 0 is full quality.
+
+struct SimLevel {
+    int subSteps;
+    int aiInterval;
+};
+
+struct RenderLevel {
+    int circlePoints;
+    float renderScale;
+};
+
+static const SimLevel simLadder[] = {
+    { SUB_STEPS, 1 },
+    { 3, 1 },
+    { 3, 2 },
+    { 2, 2 },
+    { 2, 3 },
+};
+
+static const RenderLevel renderLadder[] = {
+    { 30, 1.f },
+    { 20, 1.f },
+    { 20, 0.85f },
+    { 14, 0.75f },
+    { 12, 0.6f },
+    { 10, RENDER_SCALE_MIN },
+};
+
+constexpr int SIM_LEVELS = sizeof(simLadder) / sizeof(simLadder[0]);
+constexpr int RENDER_LEVELS = sizeof(renderLadder) / sizeof(renderLadder[0]);
+
+// hysteresis: over 90% of budget for a while -> one step down,
+// under 60% for much longer -> one step up, then hold. A step up that is
+// undone within GOV_REVERT_FRAMES doubles the wait before the next one, so
+// a level that sits right at the edge is not retried every few seconds.
+constexpr float GOV_OVER = 0.9f;
+constexpr float GOV_UNDER = 0.6f;
+constexpr int   GOV_DOWN_FRAMES = 30;
+constexpr int   GOV_UP_FRAMES = 180;
+constexpr int   GOV_HOLD_FRAMES = 60;
+constexpr int   GOV_REVERT_FRAMES = 600;
+constexpr int   GOV_MAX_BACKOFF = 4;    // up to 16x GOV_UP_FRAMES
+
+static void applyLevels(QualityGovernor& gov)
+{
+    const SimLevel& s = simLadder[gov.simLevel.level];
+    const RenderLevel& r = renderLadder[gov.renderLevel.level];
+    gov.settings.subSteps = s.subSteps;
+    gov.settings.aiInterval = s.aiInterval;
+    gov.settings.circlePoints = r.circlePoints;
+    gov.settings.renderScale = r.renderScale;
+}
+
+void setupGovernor(QualityGovernor& gov, float targetMs)
+{
+    gov = QualityGovernor{};
+    gov.targetMs = targetMs;
+    applyLevels(gov);
+}
+
+static int upFrames(const GovernorLadder& ladder)
+{
+    return GOV_UP_FRAMES << std::min(ladder.backoff, GOV_MAX_BACKOFF);
+}
+
+// one ladder's controller; returns +1 / -1 when it wants to move
+static int stepLadder(GovernorLadder& ladder, float sampleMs, float targetMs, int levels)
+{
+    ladder.avgMs += (sampleMs - ladder.avgMs) * 0.05f;
+
+    // the last step up held long enough: back to the normal wait
+    if (ladder.sinceUp >= 0 && ++ladder.sinceUp > GOV_REVERT_FRAMES)
+    {
+        ladder.sinceUp = -1;
+        ladder.backoff = 0;
+    }
+
+    if (ladder.hold > 0)
+    {
+        --ladder.hold;
+        return 0;
+    }
+
+    ladder.over = ladder.avgMs > targetMs * GOV_OVER ? ladder.over + 1 : 0;
+    ladder.under = ladder.avgMs < targetMs * GOV_UNDER ? ladder.under + 1 : 0;
+
+    int move = 0;
+    if (ladder.over >= GOV_DOWN_FRAMES && ladder.level + 1 < levels)
+        move = 1;
+    else if (ladder.under >= upFrames(ladder) && ladder.level > 0)
+        move = -1;
+
+    if (move != 0)
+    {
+        if (move > 0 && ladder.sinceUp >= 0)
+            ++ladder.backoff;
+        ladder.sinceUp = move < 0 ? 0 : -1;
+        ladder.level += move;
+        ladder.over = 0;
+        ladder.under = 0;
+        ladder.hold = GOV_HOLD_FRAMES;
+    }
+    return move;
+}
+
+// after a step down: how long until the level above is tried again
+static std::string backoffNote(const GovernorLadder& ladder, int move)
+{
+    if (move < 0 || ladder.backoff == 0)
+        return "";
+    return ", next step up waits " + std::to_string(upFrames(ladder)) + " frames";
+}
+
+void updateGovernor(QualityGovernor& gov, float simMs, float renderMs)
+{
+    int simMove = stepLadder(gov.simLevel, simMs, gov.targetMs, SIM_LEVELS);
+    int renderMove = stepLadder(gov.renderLevel, renderMs, gov.targetMs, RENDER_LEVELS);
+    if (simMove == 0 && renderMove == 0)
+        return;
+
+    applyLevels(gov);
+    const QualitySettings& q = gov.settings;
+
+    if (simMove != 0)
+        std::cout << "governor: sim " << (simMove > 0 ? "down" : "up")
+            << " to level " << gov.simLevel.level
+            << " (sim " << gov.simLevel.avgMs << " ms of " << gov.targetMs << ")"
+            << " -> sub-steps " << q.subSteps
+            << ", AI every " << q.aiInterval << " ticks" << backoffNote(gov.simLevel, simMove) << "\n";
+    if (renderMove != 0)
+        std::cout << "governor: render " << (renderMove > 0 ? "down" : "up")
+            << " to level " << gov.renderLevel.level
+            << " (render " << gov.renderLevel.avgMs << " ms of " << gov.targetMs << ")"
+            << " -> circle points " << q.circlePoints
+            << ", render scale " << q.renderScale << backoffNote(gov.renderLevel, renderMove) << "\n";
+}
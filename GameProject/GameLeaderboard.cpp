@@ -0,0 +1,333 @@
+#include "GameProject.hpp"
+#include <cstring>
+#include <cstdlib>
+#include <ctime>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+// FILES (little endian)
+//   runs.log         RunRecord, RunRecord, ...   only ever appended to
+//   leaderboard.idx  IndexHeader + count RunRecords, replaced atomically
+// The index remembers how many log bytes it has seen, so loading reads the
+// K entries plus whatever was appended after them (normally nothing).
+
+static_assert(sizeof(RunRecord) == 48, "run log records are fixed size");
+
+constexpr char     INDEX_MAGIC[8] = { 'B', 'B', 'S', 'T', 'O', 'P', 'K', '1' };
+constexpr uint32_t INDEX_VERSION = 1;
+
+struct IndexHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t count;
+    uint64_t logBytes;
+};
+
+uint32_t crc32(const void* data, size_t size)
+{
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; ++i)
+    {
+        crc ^= p[i];
+        for (int bit = 0; bit < 8; ++bit)
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+    }
+    return ~crc;
+}
+
+static uint32_t recordCrc(const RunRecord& run)
+{
+    RunRecord copy = run;
+    copy.crc = 0;
+    return crc32(&copy, sizeof(copy));
+}
+
+// std::getenv is C4996 under MSVC
+static std::string envVar(const char* key)
+{
+#ifdef _MSC_VER
+    char* value = nullptr;
+    size_t length = 0;
+    std::string result;
+    if (_dupenv_s(&value, &length, key) == 0 && value)
+        result = value;
+    std::free(value);
+    return result;
+#else
+    const char* value = std::getenv(key);
+    return value ? value : "";
+#endif
+}
+
+// whoever is logged in, so shared machines keep separate histories
+static std::string playerName()
+{
+    std::string name = envVar("USERNAME");
+    if (name.empty()) name = envVar("USER");
+    return name.empty() ? "player" : name;
+}
+
+RunRecord makeRunRecord(const Arena& arena)
+{
+    RunRecord run;
+    std::memset(&run, 0, sizeof(run));
+    std::string name = playerName();
+    std::memcpy(run.player, name.data(), std::min(name.size(), sizeof(run.player) - 1));
+    run.score = arena.player.score;
+    run.ticks = arena.stats.ticks;
+    run.kills = arena.stats.kills;
+    run.shots = arena.stats.shots;
+    for (const auto& e : arena.enemies)
+        if (e.alive) ++run.enemiesAlive;
+    run.timestamp = (int64_t)std::time(nullptr);
+    run.crc = recordCrc(run);
+    return run;
+}
+
+// O(K): slide lower scores down one place (ties keep the older run first)
+void insertRun(Leaderboard& board, const RunRecord& run)
+{
+    int pos = board.count;
+    while (pos > 0 && board.top[pos - 1].score < run.score)
+        --pos;
+    if (pos >= LEADERBOARD_K)
+        return;
+
+    int last = std::min(board.count, LEADERBOARD_K - 1);
+    for (int i = last; i > pos; --i)
+        board.top[i] = board.top[i - 1];
+    board.top[pos] = run;
+    board.count = std::min(board.count + 1, LEADERBOARD_K);
+}
+
+static bool readIndex(Leaderboard& board, const char* indexPath)
+{
+    std::FILE* f = openFile(indexPath, "rb");
+    if (!f)
+        return false;
+
+    IndexHeader header;
+    bool ok = std::fread(&header, sizeof(header), 1, f) == 1 &&
+        std::memcmp(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) == 0 &&
+        header.version == INDEX_VERSION &&
+        header.count <= (uint32_t)LEADERBOARD_K &&
+        std::fread(board.top, sizeof(RunRecord), header.count, f) == header.count;
+    std::fclose(f);
+
+    for (uint32_t i = 0; ok && i < header.count; ++i)
+        ok = board.top[i].crc == recordCrc(board.top[i]);
+    if (!ok)
+        return false;
+
+    board.count = (int)header.count;
+    board.logBytes = header.logBytes;
+    return true;
+}
+
+// 64-bit offsets: long is 32 bits on Windows
+static bool seekFile(std::FILE* f, uint64_t offset, int origin)
+{
+#ifdef _WIN32
+    return _fseeki64(f, (long long)offset, origin) == 0;
+#else
+    return fseeko(f, (off_t)offset, origin) == 0;
+#endif
+}
+
+static uint64_t tellFile(std::FILE* f)
+{
+#ifdef _WIN32
+    return (uint64_t)_ftelli64(f);
+#else
+    return (uint64_t)ftello(f);
+#endif
+}
+
+static void truncateFile(std::FILE* f, uint64_t size)
+{
+#ifdef _WIN32
+    _chsize_s(_fileno(f), (long long)size);
+#else
+    if (ftruncate(fileno(f), (off_t)size) != 0)
+        std::cout << "Failed to trim " << RUN_LOG << "\n";
+#endif
+}
+
+// Ranks every whole record past board.logBytes and moves logBytes to the
+// end of them. Returns how many were added, -1 if there is no log. Records
+// are fixed size, so a damaged one in the middle is skipped and the rest
+// still line up. Only the loader trims, and only a final partial record:
+// while the game runs, a bad or short tail may be another process still
+// appending, so it is left for the next catch-up.
+int catchUpLeaderboard(Leaderboard& board, const char* logPath, bool trimTail)
+{
+    std::FILE* log = openFile(logPath, trimTail ? "rb+" : "rb");
+    if (!log)
+        return -1;
+
+    seekFile(log, 0, SEEK_END);
+    uint64_t logSize = tellFile(log);
+
+    // index from another log (or damaged): rebuild from the start
+    if (board.logBytes > logSize || board.logBytes % sizeof(RunRecord) != 0)
+        board = Leaderboard{};
+
+    uint64_t good = board.logBytes;   // end of the last record ranked
+    uint64_t end = good;              // end of the last whole record read
+    seekFile(log, good, SEEK_SET);
+    RunRecord run;
+    int caughtUp = 0;
+    int damaged = 0;
+    int pending = 0;                  // bad records not yet followed by a good one
+    while (std::fread(&run, sizeof(run), 1, log) == 1)
+    {
+        end += sizeof(run);
+        if (run.crc != recordCrc(run))
+        {
+            ++pending;
+            continue;
+        }
+        insertRun(board, run);
+        good = end;
+        damaged += pending;
+        pending = 0;
+        ++caughtUp;
+    }
+
+    if (trimTail)
+    {
+        damaged += pending;
+        good = end;
+    }
+    if (damaged > 0)
+        std::cout << "Skipped " << damaged << " damaged runs in " << logPath << "\n";
+
+    if (trimTail && end < logSize)
+    {
+        std::cout << "Dropping " << logSize - end << " bytes of a partial run at the end of " << logPath << "\n";
+        truncateFile(log, end);
+    }
+    std::fclose(log);
+
+    board.logBytes = good;
+    return caughtUp;
+}
+
+// Index first, then only the log records it has not seen. A torn record at
+// the end (crash mid-append) is cut off so the next append stays aligned.
+bool loadLeaderboard(Leaderboard& board, const char* indexPath, const char* logPath)
+{
+    board = Leaderboard{};
+    bool indexed = readIndex(board, indexPath);
+    if (!indexed)
+        board = Leaderboard{};
+
+    int caughtUp = catchUpLeaderboard(board, logPath, true);
+    if (caughtUp < 0)
+    {
+        // an index without its log describes runs that are gone
+        if (board.logBytes > 0)
+            board = Leaderboard{};
+        return indexed;
+    }
+
+    if (caughtUp > 0)
+        std::cout << "Leaderboard caught up on " << caughtUp << " runs from " << logPath << "\n";
+    return true;
+}
+
+// one fixed-size record on the end of the log, on disk before returning
+bool appendRun(const char* logPath, const RunRecord& run)
+{
+    std::FILE* f = openFile(logPath, "ab");
+    if (!f)
+        return false;
+
+    bool ok = std::fwrite(&run, sizeof(run), 1, f) == 1 && syncFile(f);
+    return std::fclose(f) == 0 && ok;
+}
+
+bool writeLeaderboardIndex(const char* indexPath, const Leaderboard& board)
+{
+    unsigned char data[sizeof(IndexHeader) + sizeof(RunRecord) * LEADERBOARD_K];
+
+    IndexHeader header{};
+    std::memcpy(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    header.version = INDEX_VERSION;
+    header.count = (uint32_t)board.count;
+    header.logBytes = board.logBytes;
+
+    std::memcpy(data, &header, sizeof(header));
+    std::memcpy(data + sizeof(header), board.top, sizeof(RunRecord) * board.count);
+    return writeFileAtomic(indexPath, data, sizeof(header) + sizeof(RunRecord) * board.count);
+}
+
+static void printRun(int rank, const RunRecord& run)
+{
+    char when[32] = "?";
+    std::time_t t = (std::time_t)run.timestamp;
+    std::tm tm;
+#ifdef _MSC_VER
+    bool ok = localtime_s(&tm, &t) == 0;
+#else
+    bool ok = localtime_r(&t, &tm) != nullptr;
+#endif
+    if (ok)
+        std::strftime(when, sizeof(when), "%Y-%m-%d %H:%M", &tm);
+
+    std::printf("%3d  %-15.15s %6d  %6.1f s  %4u kills  %4u shots  %3u left  %s\n",
+        rank, run.player, run.score, run.ticks * DT, run.kills, run.shots, run.enemiesAlive, when);
+}
+
+// --leaderboard: the index alone, no log parse
+int runLeaderboard()
+{
+    Leaderboard board;
+    loadLeaderboard(board, RUN_INDEX, RUN_LOG);
+
+    std::cout << "Top " << LEADERBOARD_K << " runs:\n";
+    for (int i = 0; i < board.count; ++i)
+        printRun(i + 1, board.top[i]);
+    if (board.count == 0)
+        std::cout << "  (no runs yet)\n";
+    return 0;
+}
+
+// --history [player]: every run of one player, oldest first (full log scan)
+int runHistory(const char* player)
+{
+    std::string self;
+    if (!player)
+    {
+        self = playerName();
+        player = self.c_str();
+    }
+
+    std::FILE* log = openFile(RUN_LOG, "rb");
+    if (!log)
+    {
+        std::cout << "No runs recorded yet\n";
+        return 0;
+    }
+
+    std::cout << "Runs by " << player << ":\n";
+    RunRecord run;
+    int n = 0;
+    while (std::fread(&run, sizeof(run), 1, log) == 1)
+    {
+        if (run.crc != recordCrc(run))
+            break;
+        if (std::strncmp(run.player, player, sizeof(run.player) - 1) == 0)
+            printRun(++n, run);
+    }
+    std::fclose(log);
+
+    if (n == 0)
+        std::cout << "  (none)\n";
+    return 0;
+}
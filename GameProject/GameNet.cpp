@@ -0,0 +1,733 @@
+#include "GameProject.hpp"
+#include <SFML/Network.hpp>
+#include <map>
+#include <memory>
+
+// packet types (first byte of every datagram)
+enum NetPacket : uint8_t {
+    NET_HELLO = 1,      // client -> server: give me an arena
+    NET_INPUT = 2,      // client -> server: ack tick + input bits
+    NET_SNAPSHOT = 3    // server -> client: delta snapshot
+};
+
+constexpr int   NET_INTERP_TICKS = 2;    // client renders this far behind
+constexpr float NET_TIMEOUT = 5.f;       // seconds of silence before a client is dropped
+constexpr float NET_REMATCH_DELAY = 2.f; // seconds between round end and reset
+
+// BYTE PACKING
+
+static void putByte(NetBuffer& b, uint8_t v)
+{
+    if (b.size >= (int)sizeof(b.data))
+    {
+        b.overflow = true;
+        return;
+    }
+    b.data[b.size++] = v;
+}
+
+static void putVarint(NetBuffer& b, uint32_t v)
+{
+    while (v >= 0x80)
+    {
+        putByte(b, uint8_t(v | 0x80));
+        v >>= 7;
+    }
+    putByte(b, uint8_t(v));
+}
+
+// zigzag so small negative deltas stay small
+static void putSigned(NetBuffer& b, int32_t v)
+{
+    putVarint(b, (uint32_t(v) << 1) ^ uint32_t(v >> 31));
+}
+
+static uint8_t getByte(NetBuffer& b)
+{
+    if (b.read >= b.size)
+    {
+        b.overflow = true;
+        return 0;
+    }
+    return b.data[b.read++];
+}
+
+static uint32_t getVarint(NetBuffer& b)
+{
+    uint32_t v = 0;
+    for (int shift = 0; shift < 35; shift += 7)
+    {
+        uint8_t c = getByte(b);
+        v |= uint32_t(c & 0x7f) << shift;
+        if (!(c & 0x80))
+            break;
+    }
+    return v;
+}
+
+static int32_t getSigned(NetBuffer& b)
+{
+    uint32_t v = getVarint(b);
+    return int32_t(v >> 1) ^ -int32_t(v & 1);
+}
+
+// QUANTIZATION
+
+static int16_t quant(float v, float scale)
+{
+    long q = std::lround(v * scale);
+    return (int16_t)std::clamp(q, -32767L, 32767L);
+}
+
+static NetEntity packBody(b2BodyId id, uint8_t flags, sf::Color color)
+{
+    NetEntity n;
+    b2Vec2 p = b2Body_GetPosition(id);
+    b2Vec2 v = b2Body_GetLinearVelocity(id);
+    n.x = quant(p.x, NET_POS_SCALE);
+    n.y = quant(p.y, NET_POS_SCALE);
+    n.vx = quant(v.x, NET_VEL_SCALE);
+    n.vy = quant(v.y, NET_VEL_SCALE);
+    n.flags = flags;
+    n.color = color.toInteger();
+    return n;
+}
+
+void buildSnapshot(const Arena& arena, Snapshot& snap)
+{
+    const Player& player = arena.player;
+
+    snap.tick = arena.tick;
+    snap.score = player.score;
+    snap.state = (arena.gameOver ? 1 : 0) |
+        (arena.playerWon ? 2 : 0) |
+        (player.muzzleTimer > 0.f ? 4 : 0);
+    snap.player = packBody(player.id, 1 | (player.dir < 0.f ? 2 : 0), sf::Color::Cyan);
+
+    int enemyCount = std::min((int)arena.enemies.size(), NET_MAX_ENEMIES);
+    snap.enemyCount = (uint8_t)enemyCount;
+    for (int i = 0; i < enemyCount; ++i)
+    {
+        const Enemy& e = arena.enemies[i];
+        // dead enemies no longer have a body
+        if (e.alive)
+            snap.enemies[i] = packBody(e.id, 1, e.color);
+        else
+            snap.enemies[i] = NetEntity{};
+    }
+
+    int bulletCount = std::min((int)arena.bullets.size(), NET_MAX_BULLETS);
+    snap.bulletCount = (uint8_t)bulletCount;
+    for (int i = 0; i < bulletCount; ++i)
+        snap.bullets[i] = packBody(arena.bullets[i].id, 1, sf::Color::Yellow);
+}
+
+// DELTA CODING
+// Layout: tick, baseline tick (0 = none), header deltas, then a bitset of
+// changed slots followed by a field mask + field deltas for each of them.
+
+static const NetEntity kNoEntity{};
+static const Snapshot  kNoSnapshot{};
+
+// slot 0 = player, then the snapshot's own enemies, then its bullets, so
+// the bitset only covers what the arena has. The baseline is read at the
+// same entity index using the coded snapshot's layout.
+static const NetEntity& slotOf(const Snapshot& s, const Snapshot& layout, int slot)
+{
+    if (slot == 0)
+        return s.player;
+    slot -= 1;
+    if (slot < layout.enemyCount)
+        return slot < s.enemyCount ? s.enemies[slot] : kNoEntity;
+    slot -= layout.enemyCount;
+    return slot < s.bulletCount ? s.bullets[slot] : kNoEntity;
+}
+
+static NetEntity& slotOf(Snapshot& s, int slot)
+{
+    if (slot == 0)
+        return s.player;
+    slot -= 1;
+    if (slot < s.enemyCount)
+        return s.enemies[slot];
+    return s.bullets[slot - s.enemyCount];
+}
+
+static int slotCount(const Snapshot& s)
+{
+    return 1 + s.enemyCount + s.bulletCount;
+}
+
+static uint8_t fieldMask(const NetEntity& a, const NetEntity& b)
+{
+    return (a.x != b.x ? 1 : 0) |
+        (a.y != b.y ? 2 : 0) |
+        (a.vx != b.vx ? 4 : 0) |
+        (a.vy != b.vy ? 8 : 0) |
+        (a.flags != b.flags ? 16 : 0) |
+        (a.color != b.color ? 32 : 0);
+}
+
+void encodeSnapshot(const Snapshot& snap, const Snapshot* baseline, NetBuffer& out)
+{
+    const Snapshot& base = baseline ? *baseline : kNoSnapshot;
+
+    putVarint(out, snap.tick);
+    putVarint(out, baseline ? baseline->tick : 0);
+    putSigned(out, snap.score - base.score);
+    putByte(out, snap.state);
+    putByte(out, snap.enemyCount);
+    putByte(out, snap.bulletCount);
+
+    // changed-slot bitset
+    int slots = slotCount(snap);
+    uint8_t masks[1 + NET_MAX_ENEMIES + NET_MAX_BULLETS];
+    for (int byte = 0; byte < (slots + 7) / 8; ++byte)
+    {
+        uint8_t bits = 0;
+        for (int bit = 0; bit < 8; ++bit)
+        {
+            int slot = byte * 8 + bit;
+            if (slot >= slots)
+                break;
+            masks[slot] = fieldMask(slotOf(snap, snap, slot), slotOf(base, snap, slot));
+            if (masks[slot])
+                bits |= uint8_t(1 << bit);
+        }
+        putByte(out, bits);
+    }
+
+    for (int slot = 0; slot < slots; ++slot)
+    {
+        uint8_t mask = masks[slot];
+        if (!mask)
+            continue;
+
+        const NetEntity& e = slotOf(snap, snap, slot);
+        const NetEntity& b = slotOf(base, snap, slot);
+        putByte(out, mask);
+        if (mask & 1)  putSigned(out, e.x - b.x);
+        if (mask & 2)  putSigned(out, e.y - b.y);
+        if (mask & 4)  putSigned(out, e.vx - b.vx);
+        if (mask & 8)  putSigned(out, e.vy - b.vy);
+        if (mask & 16) putByte(out, e.flags);
+        if (mask & 32)
+        {
+            for (int k = 0; k < 4; ++k)
+                putByte(out, uint8_t(e.color >> (24 - 8 * k)));
+        }
+    }
+}
+
+bool decodeSnapshot(NetBuffer& in, const Snapshot* (*findBaseline)(void* ctx, uint32_t tick),
+    void* ctx, Snapshot& snap)
+{
+    uint32_t tick = getVarint(in);
+    uint32_t baseTick = getVarint(in);
+
+    const Snapshot* baseline = nullptr;
+    if (baseTick != 0)
+    {
+        baseline = findBaseline(ctx, baseTick);
+        if (!baseline)
+            return false;   // baseline already dropped; wait for the next one
+    }
+    const Snapshot& base = baseline ? *baseline : kNoSnapshot;
+
+    snap.tick = tick;
+    snap.score = base.score + getSigned(in);
+    snap.state = getByte(in);
+    snap.enemyCount = (uint8_t)std::min<int>(getByte(in), NET_MAX_ENEMIES);
+    snap.bulletCount = (uint8_t)std::min<int>(getByte(in), NET_MAX_BULLETS);
+
+    int slots = slotCount(snap);
+    uint8_t changed[(1 + NET_MAX_ENEMIES + NET_MAX_BULLETS + 7) / 8];
+    for (int byte = 0; byte < (slots + 7) / 8; ++byte)
+        changed[byte] = getByte(in);
+
+    for (int slot = 0; slot < slots; ++slot)
+    {
+        NetEntity& e = slotOf(snap, slot);
+        e = slotOf(base, snap, slot);
+        if (!(changed[slot / 8] & (1 << (slot % 8))))
+            continue;
+
+        uint8_t mask = getByte(in);
+        if (mask & 1)  e.x = int16_t(e.x + getSigned(in));
+        if (mask & 2)  e.y = int16_t(e.y + getSigned(in));
+        if (mask & 4)  e.vx = int16_t(e.vx + getSigned(in));
+        if (mask & 8)  e.vy = int16_t(e.vy + getSigned(in));
+        if (mask & 16) e.flags = getByte(in);
+        if (mask & 32)
+        {
+            uint32_t c = 0;
+            for (int k = 0; k < 4; ++k)
+                c = (c << 8) | getByte(in);
+            e.color = c;
+        }
+    }
+
+    return !in.overflow;
+}
+
+// SERVER
+
+struct ServerClient {
+    bool active = false;
+    sf::IpAddress addr;
+    unsigned short port = 0;
+    uint32_t ackTick = 0;
+    PlayerInput input;
+    float silence = 0.f;
+};
+
+struct ServerArena {
+    Arena arena;
+    ServerClient client;
+    float roundOverTimer = 0.f;
+    Snapshot history[NET_HISTORY];  // indexed by tick % NET_HISTORY
+    NetBuffer out;
+};
+
+struct ServerTick {
+    std::vector<std::unique_ptr<ServerArena>>* arenas = nullptr;
+    uint32_t tick = 0;
+};
+
+static uint64_t endpointKey(const sf::IpAddress& addr, unsigned short port)
+{
+    return (uint64_t(addr.toInteger()) << 16) | port;
+}
+
+static void serverTickTask(void* ctx, int begin, int end)
+{
+    ServerTick& st = *static_cast<ServerTick*>(ctx);
+
+    for (int i = begin; i < end; ++i)
+    {
+        ServerArena& sa = *(*st.arenas)[i];
+        Arena& arena = sa.arena;
+
+        stepArena(arena, sa.client.active ? sa.client.input : botInput(arena));
+
+        // short pause on the result, then a fresh round
+        if (arena.gameOver || arena.playerWon)
+        {
+            sa.roundOverTimer += DT;
+            if (sa.roundOverTimer >= NET_REMATCH_DELAY)
+            {
+                resetArena(arena, arena.enemyCap, 0);
+                sa.roundOverTimer = 0.f;
+            }
+        }
+
+        Snapshot& snap = sa.history[st.tick % NET_HISTORY];
+        buildSnapshot(arena, snap);
+        snap.tick = st.tick;    // server tick, so it keeps counting during round-over
+
+        sa.out.size = 0;
+        sa.out.overflow = false;
+        if (!sa.client.active)
+            continue;
+
+        const Snapshot* baseline = nullptr;
+        uint32_t ack = sa.client.ackTick;
+        if (ack != 0 && st.tick - ack < NET_HISTORY && sa.history[ack % NET_HISTORY].tick == ack)
+            baseline = &sa.history[ack % NET_HISTORY];
+
+        putByte(sa.out, NET_SNAPSHOT);
+        encodeSnapshot(snap, baseline, sa.out);
+
+        // a delta that does not fit is retried in full; the send loop drops
+        // whatever still overflows
+        if (sa.out.overflow && baseline)
+        {
+            sa.out.size = 0;
+            sa.out.overflow = false;
+            putByte(sa.out, NET_SNAPSHOT);
+            encodeSnapshot(snap, nullptr, sa.out);
+        }
+    }
+}
+
+int runServer(unsigned short port, int arenaCount, int threadCount, int enemiesPerArena)
+{
+    arenaCount = std::max(1, arenaCount);
+    threadCount = std::max(1, threadCount);
+    enemiesPerArena = std::clamp(enemiesPerArena, 1, NET_MAX_ENEMIES);
+
+    sf::UdpSocket socket;
+    if (socket.bind(port) != sf::Socket::Done)
+    {
+        std::cout << "Failed to bind UDP port " << port << "\n";
+        return 1;
+    }
+    socket.setBlocking(false);
+
+    std::vector<std::unique_ptr<ServerArena>> arenas;
+    std::random_device seeder;
+    for (int i = 0; i < arenaCount; ++i)
+    {
+        arenas.push_back(std::make_unique<ServerArena>());
+        setupArena(arenas.back()->arena, seeder(), enemiesPerArena);
+    }
+    std::map<uint64_t, int> clientArena;
+
+    WorkerPool pool;
+    startWorkerPool(pool, threadCount);
+
+    std::cout << "Server on UDP " << port << ": " << arenaCount << " arenas, "
+        << enemiesPerArena << " enemies each, " << threadCount << " threads\n";
+
+    ServerTick st;
+    st.arenas = &arenas;
+
+    sf::Clock frameClock;
+    sf::Clock statsClock;
+    float acc = 0.f;
+    double busySeconds = 0.0;
+    uint64_t statTicks = 0;
+    uint64_t statBytes = 0;
+    uint64_t statDropped = 0;      // snapshots too big even without a baseline
+
+    uint8_t buf[sf::UdpSocket::MaxDatagramSize];
+
+    for (;;)
+    {
+        // RECEIVE
+        std::size_t received = 0;
+        sf::IpAddress from;
+        unsigned short fromPort = 0;
+        while (socket.receive(buf, sizeof(buf), received, from, fromPort) == sf::Socket::Done)
+        {
+            if (received == 0) continue;
+            uint64_t key = endpointKey(from, fromPort);
+            auto known = clientArena.find(key);
+
+            if (buf[0] == NET_HELLO && known == clientArena.end())
+            {
+                auto freeArena = std::find_if(arenas.begin(), arenas.end(),
+                    [](const std::unique_ptr<ServerArena>& a) { return !a->client.active; });
+                if (freeArena == arenas.end())
+                {
+                    std::cout << "Server full, ignoring " << from.toString() << "\n";
+                    continue;
+                }
+
+                ServerArena& sa = **freeArena;
+                sa.client = ServerClient{};
+                sa.client.active = true;
+                sa.client.addr = from;
+                sa.client.port = fromPort;
+                resetArena(sa.arena, sa.arena.enemyCap, 0);
+                sa.roundOverTimer = 0.f;
+
+                int index = (int)(freeArena - arenas.begin());
+                clientArena[key] = index;
+                std::cout << "Client " << from.toString() << ":" << fromPort
+                    << " joined arena " << index << "\n";
+            }
+            else if (buf[0] == NET_INPUT && known != clientArena.end())
+            {
+                NetBuffer in;
+                in.size = (int)std::min(received, sizeof(in.data));
+                std::copy(buf, buf + in.size, in.data);
+                in.read = 1;
+
+                uint32_t ack = getVarint(in);
+                uint8_t bits = getByte(in);
+                if (in.overflow) continue;
+
+                ServerClient& c = arenas[known->second]->client;
+                if (ack > c.ackTick && ack <= st.tick)
+                    c.ackTick = ack;
+                c.input.left = bits & 1;
+                c.input.right = bits & 2;
+                c.input.jump = bits & 4;
+                c.input.shoot = bits & 8;
+                c.silence = 0.f;
+            }
+        }
+
+        // FIXED TICK
+        acc += frameClock.restart().asSeconds();
+        if (acc < DT)
+        {
+            sf::sleep(sf::milliseconds(1));
+            continue;
+        }
+        acc -= DT;
+        if (acc > 0.25f) acc = 0.f;    // fell far behind, don't spiral
+
+        ++st.tick;
+        sf::Clock work;
+        parallelFor(pool, (int)arenas.size(), 1, serverTickTask, &st);
+        busySeconds += work.getElapsedTime().asSeconds();
+        ++statTicks;
+
+        // SEND + TIMEOUTS
+        for (auto& a : arenas)
+        {
+            ServerClient& c = a->client;
+            if (!c.active) continue;
+
+            c.silence += DT;
+            if (c.silence > NET_TIMEOUT)
+            {
+                std::cout << "Client " << c.addr.toString() << ":" << c.port << " timed out\n";
+                clientArena.erase(endpointKey(c.addr, c.port));
+                c.active = false;
+                continue;
+            }
+
+            if (a->out.overflow)
+                ++statDropped;
+            else if (a->out.size > 0)
+            {
+                socket.send(a->out.data, (std::size_t)a->out.size, c.addr, c.port);
+                statBytes += (uint64_t)a->out.size;
+            }
+        }
+
+        // STATS
+        float elapsed = statsClock.getElapsedTime().asSeconds();
+        if (elapsed >= 5.f)
+        {
+            double busyFraction = busySeconds / elapsed;
+            double matchesPerCore = busyFraction > 0.0
+                ? arenas.size() / (busyFraction * threadCount)
+                : 0.0;
+            int clients = (int)clientArena.size();
+
+            // Box2D's own counters: how much pair work the worlds carry
+            int contacts = 0;
+            for (auto& a : arenas)
+                contacts += b2World_GetCounters(a->arena.world).contactCount;
+
+            std::cout << "tick " << (busySeconds / statTicks) * 1000.0 << " ms"
+                << " | matches/core " << matchesPerCore
+                << " | contacts/arena " << contacts / (int)arenas.size()
+                << " | clients " << clients
+                << " | bytes/client/s "
+                << (clients > 0 ? statBytes / elapsed / clients : 0.0) << "\n";
+            if (statDropped > 0)
+                std::cout << "dropped " << statDropped << " snapshots larger than "
+                    << sizeof(NetBuffer::data) << " bytes\n";
+
+            statsClock.restart();
+            busySeconds = 0.0;
+            statTicks = 0;
+            statBytes = 0;
+            statDropped = 0;
+        }
+    }
+
+    // not reached; the server runs until the process is killed
+}
+
+// CLIENT
+
+struct ClientHistory {
+    std::vector<Snapshot> ring = std::vector<Snapshot>(NET_HISTORY);
+};
+
+static const Snapshot* clientBaseline(void* ctx, uint32_t tick)
+{
+    ClientHistory& h = *static_cast<ClientHistory*>(ctx);
+    const Snapshot& s = h.ring[tick % NET_HISTORY];
+    return s.tick == tick ? &s : nullptr;
+}
+
+static sf::Vector2f lerpPos(const NetEntity& a, const NetEntity& b, float t)
+{
+    b2Vec2 p = {
+        (a.x + (b.x - a.x) * t) / NET_POS_SCALE,
+        (a.y + (b.y - a.y) * t) / NET_POS_SCALE
+    };
+    return toSFML(p);
+}
+
+int runNetClient(const std::string& host, unsigned short port)
+{
+    sf::IpAddress server(host);
+    sf::UdpSocket socket;
+    if (socket.bind(sf::Socket::AnyPort) != sf::Socket::Done)
+    {
+        std::cout << "Failed to open a UDP socket\n";
+        return 1;
+    }
+    socket.setBlocking(false);
+
+    sf::RenderWindow window(sf::VideoMode(1600, 900), "Battle Box Shooter (net)");
+    window.setFramerateLimit(60);
+    window.setView(logicalView(window.getSize()));
+
+    sf::Texture gradient;
+    sf::RectangleShape bg;
+    setupBackground(bg, gradient);
+
+    sf::RectangleShape border;
+    std::vector<sf::RectangleShape> barGfx;
+    setupArenaGfx(border, levelBars(), barGfx);
+    border.setOutlineColor(sf::Color(0, 255, 220, 200));
+
+    // one shape per kind, moved around for every entity
+    EntityGfx gfx;
+    setupEntityGfx(gfx);
+
+    AssetArchive assets;
+    openAssetArchive(assets, ASSET_ARCHIVE);
+    sf::Font font;
+    loadAsset(font, assets, "arial.ttf");
+    sf::Text scoreText;
+    scoreText.setFont(font);
+    scoreText.setCharacterSize(32);
+    scoreText.setFillColor(sf::Color::White);
+    scoreText.setOutlineColor(sf::Color::Black);
+    scoreText.setOutlineThickness(2);
+    scoreText.setPosition(30.f, 20.f);
+
+    ClientHistory history;
+    uint32_t latest = 0;
+    double renderTick = 0.0;
+
+    sf::Clock frameClock;
+    sf::Clock helloClock;
+    sf::Clock statsClock;
+    uint64_t statBytes = 0;
+
+    uint8_t buf[sf::UdpSocket::MaxDatagramSize];
+
+    while (window.isOpen())
+    {
+        sf::Event ev;
+        while (window.pollEvent(ev))
+        {
+            if (ev.type == sf::Event::Closed)
+                window.close();
+        }
+        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Escape))
+            window.close();
+
+        float dt = frameClock.restart().asSeconds();
+
+        // SEND: hello until we get a snapshot, then input every frame
+        NetBuffer out;
+        if (latest == 0)
+        {
+            if (helloClock.getElapsedTime().asSeconds() > 0.5f)
+            {
+                putByte(out, NET_HELLO);
+                helloClock.restart();
+            }
+        }
+        else
+        {
+            bool focus = window.hasFocus();
+            uint8_t bits = 0;
+            if (focus && sf::Keyboard::isKeyPressed(sf::Keyboard::Left))  bits |= 1;
+            if (focus && sf::Keyboard::isKeyPressed(sf::Keyboard::Right)) bits |= 2;
+            if (focus && sf::Keyboard::isKeyPressed(sf::Keyboard::Space)) bits |= 4;
+            if (focus && sf::Keyboard::isKeyPressed(sf::Keyboard::S))     bits |= 8;
+
+            putByte(out, NET_INPUT);
+            putVarint(out, latest);
+            putByte(out, bits);
+        }
+        if (out.size > 0)
+            socket.send(out.data, (std::size_t)out.size, server, port);
+
+        // RECEIVE
+        std::size_t received = 0;
+        sf::IpAddress from;
+        unsigned short fromPort = 0;
+        while (socket.receive(buf, sizeof(buf), received, from, fromPort) == sf::Socket::Done)
+        {
+            if (received == 0 || buf[0] != NET_SNAPSHOT) continue;
+            statBytes += received;
+
+            NetBuffer in;
+            in.size = (int)std::min(received, sizeof(in.data));
+            std::copy(buf, buf + in.size, in.data);
+            in.read = 1;
+
+            Snapshot snap;
+            if (!decodeSnapshot(in, clientBaseline, &history, snap))
+                continue;
+            if (snap.tick <= latest && latest != 0)
+                continue;   // late or duplicate
+
+            if (latest == 0)
+                renderTick = snap.tick - NET_INTERP_TICKS;
+            history.ring[snap.tick % NET_HISTORY] = snap;
+            latest = snap.tick;
+        }
+
+        // INTERPOLATION CLOCK: run at tick rate, nudge towards latest - delay
+        renderTick += dt / DT;
+        double target = (double)latest - NET_INTERP_TICKS;
+        if (std::fabs(renderTick - target) > 10.0)
+            renderTick = target;
+        else
+            renderTick += (target - renderTick) * 0.05;
+        renderTick = std::min(renderTick, (double)latest);
+
+        // RENDER
+        window.clear();
+        window.draw(bg);
+        for (auto& r : barGfx)
+            window.draw(r);
+
+        if (latest != 0)
+        {
+            uint32_t fromTick = (uint32_t)std::floor(renderTick);
+            float t = (float)(renderTick - fromTick);
+
+            const Snapshot* a = clientBaseline(&history, fromTick);
+            const Snapshot* b = clientBaseline(&history, fromTick + 1);
+            const Snapshot& now = history.ring[latest % NET_HISTORY];
+            if (!a) a = &now;
+            if (!b) { b = a; t = 0.f; }
+
+            for (int i = 0; i < b->enemyCount; ++i)
+            {
+                const NetEntity& eb = b->enemies[i];
+                if (!(eb.flags & 1)) continue;
+                const NetEntity& ea = (i < a->enemyCount && (a->enemies[i].flags & 1)) ? a->enemies[i] : eb;
+                gfx.enemy.setFillColor(sf::Color(eb.color));
+                gfx.enemy.setPosition(lerpPos(ea, eb, t));
+                window.draw(gfx.enemy);
+            }
+
+            for (int i = 0; i < b->bulletCount; ++i)
+            {
+                const NetEntity& bb = b->bullets[i];
+                const NetEntity& ba = i < a->bulletCount ? a->bullets[i] : bb;
+                gfx.bullet.setPosition(lerpPos(ba, bb, t));
+                window.draw(gfx.bullet);
+            }
+
+            gfx.player.body.setFillColor(sf::Color(b->player.color));
+            gfx.player.body.setPosition(lerpPos(a->player, b->player, t));
+            window.draw(gfx.player.body);
+
+            scoreText.setString("Score: " + std::to_string(now.score) +
+                ((now.state & 1) ? "   GAME OVER" : (now.state & 2) ? "   YOU WIN!" : ""));
+            window.draw(scoreText);
+        }
+
+        window.draw(border);
+        window.display();
+
+        float elapsed = statsClock.getElapsedTime().asSeconds();
+        if (elapsed >= 5.f)
+        {
+            std::cout << "received " << statBytes / elapsed << " bytes/s\n";
+            statsClock.restart();
+            statBytes = 0;
+        }
+    }
+
+    closeAssetArchive(assets);
+    return 0;
+}
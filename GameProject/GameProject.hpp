@@ -4,12 +4,19 @@
 #include <SFML/Audio.hpp>
 #include <box2d/box2d.h>
 #include <vector>
-#include <deque>
 #include <cmath>
 #include <string>
 #include <algorithm>
 #include <random>
 #include <iostream>
+#include <cstdint>
+#include <cstddef>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <memory>
+#include <cstdio>
 
 // CONSTANTS 
 constexpr float PX = 30.f;             // pixels per meter
@@ -22,43 +29,211 @@ constexpr float WORLD_FLOOR = -10.f;
 constexpr float WORLD_CEIL = 10.f;
 
 constexpr int   MAX_ENEMIES = 8;
+constexpr int   MAX_ARENA_ENEMIES = 64;  // hard cap for server / batch arenas
+constexpr int   MAX_BULLETS = 16;        // 2 s life / 0.25 s cooldown = 8 alive
+
+constexpr float AUTOSAVE_SECONDS = 5.f;  // default autosave interval, 0 = off
+
+// LOGICAL RESOLUTION: world and HUD are laid out for this size, then scaled
+// (and letterboxed) to whatever the window really is
+constexpr float LOGICAL_W = 1920.f;
+constexpr float LOGICAL_H = 1080.f;
+constexpr float RENDER_SCALE_MIN = 0.5f; // lowest dynamic world resolution
 
 // SMALL HELPERS  
 
 struct Bar { float cx, cy, hx, hy; };
 
-inline sf::Vector2f toSFML(const b2Vec2& p, const sf::RenderWindow& window)
+// world meters -> logical pixels
+inline sf::Vector2f toSFML(const b2Vec2& p)
+{
+    return {
+        LOGICAL_W / 2.f + p.x * PX,
+        LOGICAL_H / 2.f - p.y * PX
+    };
+}
+
+// window pixel = origin + logical * scale
+struct Layout {
+    float scale = 1.f;
+    sf::Vector2f origin;
+};
+
+inline Layout makeLayout(sf::Vector2u windowSize)
+{
+    Layout l;
+    l.scale = std::min(windowSize.x / LOGICAL_W, windowSize.y / LOGICAL_H);
+    l.origin = {
+        std::round((windowSize.x - LOGICAL_W * l.scale) / 2.f),
+        std::round((windowSize.y - LOGICAL_H * l.scale) / 2.f)
+    };
+    return l;
+}
+
+// logical point -> whole window pixel (keeps native-size text crisp)
+inline sf::Vector2f toScreen(const Layout& l, sf::Vector2f logical)
 {
     return {
-        window.getSize().x / 2.f + p.x * PX,
-        window.getSize().y / 2.f - p.y * PX
+        std::round(l.origin.x + logical.x * l.scale),
+        std::round(l.origin.y + logical.y * l.scale)
     };
 }
 
+// view for drawing in logical units straight into the window
+inline sf::View logicalView(sf::Vector2u windowSize)
+{
+    Layout l = makeLayout(windowSize);
+    sf::View view(sf::FloatRect(0.f, 0.f, LOGICAL_W, LOGICAL_H));
+    view.setViewport(sf::FloatRect(
+        l.origin.x / windowSize.x, l.origin.y / windowSize.y,
+        LOGICAL_W * l.scale / windowSize.x, LOGICAL_H * l.scale / windowSize.y));
+    return view;
+}
+
 inline float vlen(sf::Vector2f v)
 {
     return std::sqrt(v.x * v.x + v.y * v.y);
 }
 
+// std::fopen without MSVC's C4996, which /sdl turns into an error
+inline std::FILE* openFile(const char* path, const char* mode)
+{
+#ifdef _MSC_VER
+    std::FILE* f = nullptr;
+    return fopen_s(&f, path, mode) == 0 ? f : nullptr;
+#else
+    return std::fopen(path, mode);
+#endif
+}
+
+struct AssetArchive;   // GameAssets.cpp
+
 // Implemented in GameSetup.cpp
 void addStaticBox(b2WorldId world, float cx, float cy, float hx, float hy);
+const std::vector<Bar>& levelBars();
 bool isGrounded(const b2Vec2& pos, float radius, const std::vector<Bar>& bars);
 
+// MEMORY (GameAlloc.cpp)
+// Entities live in fixed-capacity inline arrays and per-frame temporaries
+// come from a bump allocator, so a warmed-up frame never touches the heap.
+
+template <typename T, int N>
+struct FixedVector {
+    T   items[N];
+    int count = 0;
+
+    T* begin() { return items; }
+    T* end() { return items + count; }
+    const T* begin() const { return items; }
+    const T* end() const { return items + count; }
+    T& operator[](size_t i) { return items[i]; }
+    const T& operator[](size_t i) const { return items[i]; }
+    T& back() { return items[count - 1]; }
+    size_t size() const { return (size_t)count; }
+    bool empty() const { return count == 0; }
+    bool full() const { return count == N; }
+    void clear() { count = 0; }
+
+    bool push_back(const T& v)
+    {
+        if (count == N) return false;
+        items[count++] = v;
+        return true;
+    }
+
+    // keeps order, like vector::erase
+    T* erase(T* it)
+    {
+        std::move(it + 1, end(), it);
+        --count;
+        return it;
+    }
+};
+
+struct FrameArena {
+    std::unique_ptr<unsigned char[]> memory;
+    size_t capacity = 0;
+    size_t used = 0;
+};
+
+void  initFrameArena(FrameArena& arena, size_t capacity);
+void  resetFrameArena(FrameArena& arena);
+void* frameAlloc(FrameArena& arena, size_t size, size_t align = alignof(std::max_align_t));
+const char* frameFormat(FrameArena& arena, const char* fmt, ...);
+
+// counted by the global operator new replacement
+constexpr int ALLOC_WARMUP_FRAMES = 120;   // frames before "0 allocations" is expected
+uint64_t threadAllocationCount();   // calling thread only
+void countBox2DAllocations();       // b2SetAllocator hook; call before the first world
+
+// once-per-second console line when frames after warm-up allocate
+struct AllocReport {
+    const char* label = "";
+    uint64_t frames = 0;
+    uint64_t last = 0;
+    uint64_t badFrames = 0;
+    uint64_t total = 0;
+};
+
+void trackFrameAllocs(AllocReport& report);   // call at the start of every frame
+
+int runAllocCheck(int frames);
+
+// RANDOM STREAMS
+// Counter-based: the same (key, counter) always gives the same bits, so an
+// entity's numbers for a tick can be drawn on any thread, in any order.
+
+enum RandomStream : uint32_t {
+    RNG_SPAWN = 1,
+    RNG_AI = 2
+};
+
+struct RandomBlock {
+    uint32_t v[4];
+};
+
+// Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3")
+inline RandomBlock philox(uint64_t key, uint32_t c0, uint32_t c1, uint32_t c2, uint32_t c3)
+{
+    uint32_t k0 = (uint32_t)key;
+    uint32_t k1 = (uint32_t)(key >> 32);
+    uint32_t c[4] = { c0, c1, c2, c3 };
+
+    for (int round = 0; round < 10; ++round)
+    {
+        uint64_t p0 = (uint64_t)0xD2511F53u * c[0];
+        uint64_t p1 = (uint64_t)0xCD9E8D57u * c[2];
+        c[0] = (uint32_t)(p1 >> 32) ^ c[1] ^ k0;
+        c[1] = (uint32_t)p1;
+        c[2] = (uint32_t)(p0 >> 32) ^ c[3] ^ k1;
+        c[3] = (uint32_t)p0;
+        k0 += 0x9E3779B9u;
+        k1 += 0xBB67AE85u;
+    }
+    return { { c[0], c[1], c[2], c[3] } };
+}
+
+// top 24 bits -> [lo, hi)
+inline float randomRange(uint32_t bits, float lo, float hi)
+{
+    return lo + (hi - lo) * (float)(bits >> 8) * (1.f / 16777216.f);
+}
+
 // GAME OBJECTS  
 
 struct Bullet {
     b2BodyId id{};
     float life = 2.f;
-    sf::CircleShape gfx;
 };
 
 struct Enemy {
     b2BodyId id{};
+    uint32_t uid = 0;          // stable id, keys its random streams
     float radius = 0.55f;
     float speed = 4.5f;
     bool  alive = true;
     int   scoreValue = 10;
-    sf::CircleShape gfx;
+    sf::Color color;
 
     // random-path behaviour
     float sideBias = 1.f;      // -1 = prefers left side, 1 = right side
@@ -73,65 +248,655 @@ struct Player {
     float radius = 0.6f;
     int   jumps = 2;
     float dir = 1.f;       // 1 = right, -1 = left
+    float muzzleTimer = 0.f;
+};
 
-    sf::CircleShape    gfx;     // body
+typedef FixedVector<Enemy, MAX_ARENA_ENEMIES> EnemyList;
+typedef FixedVector<Bullet, MAX_BULLETS>      BulletList;
+
+// Shapes are shared per kind and moved around at draw time
+struct PlayerGfx {
+    sf::CircleShape    body;
     sf::RectangleShape gun;     // gun symbol (fire exit)
     sf::CircleShape    muzzle;  // muzzle flash
-    float muzzleTimer = 0.f;
+};
+
+struct EntityGfx {
+    PlayerGfx       player;
+    sf::CircleShape enemy;
+    sf::CircleShape bullet;
 };
 
 // ==== MODULE 1: setup =====================================================
 
-void setupWindowAndBackground(
-    sf::RenderWindow& window,
+void setupBackground(
     sf::RectangleShape& bg,
     sf::Texture& gradient);
 
 void setupWorldAndArena(
     b2WorldId& world,
+    std::vector<Bar>& bars);
+
+void setupArenaGfx(
     sf::RectangleShape& border,
-    std::vector<Bar>& bars,
-    std::vector<sf::RectangleShape>& barGfx,
-    const sf::RenderWindow& window);
+    const std::vector<Bar>& bars,
+    std::vector<sf::RectangleShape>& barGfx);
+
+// COLLISION FILTERING: one category per kind of shape. collisionMatrix says
+// which pairs Box2D should consider at all; it is read when shapes are
+// created, so change it before building a world.
+enum CollisionCategory {
+    CAT_STATIC,
+    CAT_PLAYER,
+    CAT_ENEMY,
+    CAT_BULLET,
+    CAT_SENSOR,
+    CAT_COUNT
+};
+
+extern bool collisionMatrix[CAT_COUNT][CAT_COUNT];
+
+void setCollision(CollisionCategory a, CollisionCategory b, bool collide);   // keeps it symmetric
+b2Filter collisionFilter(CollisionCategory category);
 
 // ==== MODULE 2: entities ==================================================
 
 void setupPlayer(Player& player, b2WorldId world);
+void setupEntityGfx(EntityGfx& gfx);
 
-void spawnEnemy(std::vector<Enemy>& enemies,
+// everything random about the enemy comes from philox(seed, uid)
+void spawnEnemy(EnemyList& enemies,
     b2WorldId world,
-    std::mt19937& rng,
-    std::uniform_int_distribution<int>& col,
-    std::uniform_int_distribution<int>& scoreDist,
-    std::uniform_real_distribution<float>& xSpawn,
-    std::uniform_real_distribution<float>& pathTimeDist,
-    std::uniform_real_distribution<float>& jumpCDDist);
-
-void shoot(std::deque<Bullet>& bullets,
+    uint64_t seed,
+    uint32_t uid,
+    int maxEnemies = MAX_ENEMIES);
+
+void shoot(BulletList& bullets,
     Player& player,
     float dir,
     b2WorldId world);
 
 // ==== MODULE 3: UI + audio ===============================================
 
-void setupText(sf::Font& font,
+// sizes and positions follow ui, so this runs again after a resize
+void setupText(const sf::Font& font,
     sf::Text& scoreText,
     sf::Text& title,
     sf::Text& controls,
     sf::Text& msgText,
-    const sf::RenderWindow& window);
+    const Layout& ui);
+
+// origin at the horizontal middle, so setPosition places the centre
+void centerTextX(sf::Text& text);
 
+// Effects are decoded into buffers; the looping track is streamed
 void setupAudio(sf::SoundBuffer& fireBuffer,
     sf::SoundBuffer& enemyDeadBuffer,
-    sf::SoundBuffer& gameStartBuffer,
     sf::SoundBuffer& lossBuffer,
     sf::SoundBuffer& jumpBuffer,
     sf::Sound& fireSound,
     sf::Sound& enemyDeadSound,
-    sf::Sound& gameStartSound,
     sf::Sound& lossSound,
-    sf::Sound& jumpSound);
+    sf::Sound& jumpSound,
+    sf::Music& gameStartMusic,
+    const AssetArchive& assets);
+
+// Digits pre-built once so a changing number never rebuilds a string
+struct NumberText {
+    sf::Text digits[11];    // '0'-'9', '-'
+    float advance = 0.f;
+};
+
+struct RenderStats;   // MODULE 13; digits count as HUD draws when given
+
+void setupNumberText(NumberText& number, const sf::Font& font, const sf::Text& style);
+void drawNumber(sf::RenderTarget& target, NumberText& number, const char* text, sf::Vector2f pos,
+    RenderStats* stats = nullptr);
 
 // ==== MODULE 4: whole game ===============================================
 
-int runGame();
+int runGame(float autosaveSeconds = AUTOSAVE_SECONDS);
+
+// ==== MODULE 5: simulation (GameSim.cpp) =================================
+// One arena = one Box2D world with its player, enemies and bullets.
+// Nothing in here touches a window, so arenas can run headless.
+
+struct PlayerInput {
+    bool left = false;
+    bool right = false;
+    bool jump = false;
+    bool shoot = false;
+};
+
+struct WorkerPool;   // GameThreads.cpp
+
+// scratch the step jobs hand to each other, indexed like enemies / bullets
+struct ArenaFrame {
+    PlayerInput input;
+    bool   aiRan = false;          // enemyVel is fresh this tick
+    b2Vec2 playerPos{};            // before the physics step (AI)
+    b2Vec2 playerAfter{};          // after it (hits)
+    b2Vec2 enemyVel[MAX_ARENA_ENEMIES];
+    bool   enemyHit[MAX_ARENA_ENEMIES];
+    bool   enemyTouch[MAX_ARENA_ENEMIES];
+    b2Vec2 bulletPos[MAX_BULLETS];
+};
+
+// totals for the current round (run log)
+struct RunStats {
+    uint32_t ticks = 0;
+    uint32_t kills = 0;
+    uint32_t shots = 0;
+};
+
+// things that happened during the last tick (sounds, HUD)
+struct ArenaEvents {
+    bool fired = false;
+    bool jumped = false;
+    bool enemyKilled = false;
+    bool playerDied = false;
+};
+
+struct Arena {
+    b2WorldId world{};
+    std::vector<Bar> bars;
+    Player player;
+    EnemyList enemies;
+    BulletList bullets;
+    int enemyCap = MAX_ENEMIES;
+
+    uint64_t seed = 0;             // key for every random stream
+    uint32_t nextEnemyId = 0;
+    WorkerPool* pool = nullptr;    // step jobs run here; null = caller only
+    ArenaFrame frame;
+
+    // quality knobs (see MODULE 12)
+    int subSteps = SUB_STEPS;
+    int aiInterval = 1;            // AI runs every N ticks
+
+    uint32_t tick = 0;
+    bool prevJump = false;
+    bool gameOver = false;
+    bool playerWon = false;
+    ArenaEvents events;
+    RunStats stats;
+};
+
+void setupArena(Arena& arena, unsigned seed, int enemyCap = MAX_ENEMIES);
+void resetArena(Arena& arena, int enemyCount, int score);
+void stepArena(Arena& arena, const PlayerInput& input);
+void destroyArena(Arena& arena);
+PlayerInput botInput(const Arena& arena);
+
+// contacts and step time with the filter matrix vs. everything colliding
+int runCollisionBench(int enemies, int ticks);
+
+// ==== MODULE 6: worker threads (GameThreads.cpp) =========================
+// Small fork/join pool: the calling thread helps, then waits for the rest.
+
+typedef void (*TaskFn)(void* ctx, int begin, int end);
+
+struct WorkerPool {
+    std::vector<std::thread> threads;
+    std::mutex m;
+    std::condition_variable wake;
+    std::condition_variable done;
+
+    TaskFn fn = nullptr;
+    void* ctx = nullptr;
+    int count = 0;
+    int grain = 1;
+    std::atomic<int> next{ 0 };
+    int busy = 0;
+    int slots = 0;                 // workers still allowed to join this run
+    uint64_t generation = 0;
+    uint64_t pooledRuns = 0;       // parallelFor calls that woke workers
+    bool quit = false;
+};
+
+void startWorkerPool(WorkerPool& pool, int threadCount);
+void stopWorkerPool(WorkerPool& pool);
+void parallelFor(WorkerPool& pool, int count, int grain, TaskFn fn, void* ctx);
+
+// grain that gives every thread (caller included) about one range, but
+// never below MIN_SPLIT_GRAIN: smaller ranges cost more to hand out than
+// they save, so a small count runs as one range on the caller
+constexpr int MIN_SPLIT_GRAIN = 32;
+int splitGrain(const WorkerPool* pool, int count);
+
+// JOB GRAPH: each job is a range task; it starts once every job in its
+// deps mask has finished. Ready jobs run together as one parallelFor.
+constexpr int MAX_JOBS = 16;
+
+struct Job {
+    const char* name = "";
+    TaskFn fn = nullptr;
+    void* ctx = nullptr;
+    int count = 0;
+    int grain = 1;
+    uint32_t deps = 0;     // bit i = job i first
+};
+
+struct JobGraph {
+    FixedVector<Job, MAX_JOBS> jobs;
+};
+
+uint32_t addJob(JobGraph& graph, const char* name, TaskFn fn, void* ctx,
+    int count, int grain, uint32_t deps = 0);    // returns the job's bit
+void runJobGraph(WorkerPool* pool, const JobGraph& graph);   // null pool = inline
+
+// ==== MODULE 7: network play (GameNet.cpp) ===============================
+// Headless server hosting many arenas + a thin interpolating client.
+// Snapshots are quantized and delta-coded against the last acked tick.
+
+constexpr unsigned short NET_PORT = 54000;
+constexpr int   NET_MAX_ENEMIES = MAX_ARENA_ENEMIES;
+constexpr int   NET_MAX_BULLETS = MAX_BULLETS;
+constexpr int   NET_HISTORY = 32;        // snapshots kept for delta baselines
+constexpr float NET_POS_SCALE = 64.f;    // 1/64 m per unit
+constexpr float NET_VEL_SCALE = 32.f;    // 1/32 m/s per unit
+
+struct NetEntity {
+    int16_t x = 0, y = 0;
+    int16_t vx = 0, vy = 0;
+    uint8_t flags = 0;          // bit0 = alive, bit1 = facing left
+    uint32_t color = 0;         // RGBA, only sent when it changes
+};
+
+struct Snapshot {
+    uint32_t tick = 0;
+    int32_t  score = 0;
+    uint8_t  state = 0;         // bit0 = game over, bit1 = won, bit2 = muzzle flash
+    uint8_t  enemyCount = 0;
+    uint8_t  bulletCount = 0;
+    NetEntity player;
+    NetEntity enemies[NET_MAX_ENEMIES];
+    NetEntity bullets[NET_MAX_BULLETS];
+};
+
+struct NetBuffer {
+    uint8_t data[1400];
+    int size = 0;
+    int read = 0;
+    bool overflow = false;
+};
+
+void buildSnapshot(const Arena& arena, Snapshot& snap);
+void encodeSnapshot(const Snapshot& snap, const Snapshot* baseline, NetBuffer& out);
+bool decodeSnapshot(NetBuffer& in, const Snapshot* (*findBaseline)(void* ctx, uint32_t tick),
+    void* ctx, Snapshot& snap);
+
+int runServer(unsigned short port, int arenaCount, int threadCount, int enemiesPerArena);
+int runNetClient(const std::string& host, unsigned short port);
+
+
+// ==== MODULE 8: batch environments (GameBatchEnv.cpp) ===================
+// Steps N arenas in lockstep for bot training. Callers own all buffers:
+//   actions[n]          one byte per env, bit0 left, bit1 right, bit2 jump, bit3 shoot
+//   obs[n * OBS_SIZE]   see OBS_* offsets below (meters, m/s)
+//   dones[n]            1 if the round ended this step (env is already reset)
+
+constexpr int OBS_PLAYER = 0;                       // x, y, vx, vy
+constexpr int OBS_ENEMY = 4;                        // per enemy: x, y, vx, vy, alive
+constexpr int OBS_ENEMY_STRIDE = 5;
+constexpr int OBS_SCORE = OBS_ENEMY + MAX_ENEMIES * OBS_ENEMY_STRIDE;
+constexpr int OBS_SIZE = OBS_SCORE + 1;
+
+struct BatchEnv {
+    std::vector<std::unique_ptr<Arena>> arenas;
+    WorkerPool pool;
+    int grain = 1;
+
+    // buffers of the step in flight
+    const uint8_t* actions = nullptr;
+    float* obs = nullptr;
+    uint8_t* dones = nullptr;
+};
+
+void createBatchEnv(BatchEnv& env, int envCount, int threadCount, unsigned seed);
+void destroyBatchEnv(BatchEnv& env);
+void batchReset(BatchEnv& env, float* obs);
+void batchStep(BatchEnv& env, const uint8_t* actions, float* obs, uint8_t* dones);
+void writeObservation(const Arena& arena, float* obs);
+
+int runBatchBench(int envCount, int threadCount, int steps);
+
+// ==== MODULE 9: render thread (GameRender.cpp) ==========================
+// The simulation publishes one RenderSnapshot per tick; the render thread
+// draws whichever snapshot is newest. Positions are in world meters.
+
+// Lock-free single-writer / single-reader triple buffer
+template <typename T>
+struct TripleBuffer {
+    T slots[3];
+    std::atomic<int> middle{ 1 };   // slot index, | 4 while it holds an unread value
+    int back = 0;                   // writer only
+    int front = 2;                  // reader only
+
+    T& writeSlot() { return slots[back]; }
+
+    void publish()
+    {
+        back = middle.exchange(back | 4, std::memory_order_acq_rel) & 3;
+    }
+
+    const T& read()
+    {
+        if (middle.load(std::memory_order_acquire) & 4)
+            front = middle.exchange(front, std::memory_order_acq_rel) & 3;
+        return slots[front];
+    }
+};
+
+enum class Screen : uint8_t { Title, Playing, Saved };
+enum class Message : uint8_t { None, GameOver, Won, Saved };
+
+struct RenderSprite {
+    b2Vec2 pos;
+    sf::Color color;
+};
+
+struct RenderSnapshot {
+    uint32_t tick = 0;
+    Screen   screen = Screen::Title;
+    Message  message = Message::None;
+
+    RenderSprite enemies[MAX_ARENA_ENEMIES];
+    int          enemyCount = 0;
+    b2Vec2       bullets[MAX_BULLETS];
+    int          bulletCount = 0;
+
+    b2Vec2 player{};
+    float  playerDir = 1.f;
+    bool   muzzle = false;
+
+    // animation + HUD
+    sf::Uint8 borderAlpha = 160;
+    sf::Uint8 titleAlpha = 180;
+    int  score = 0;
+    int  highScore = 0;
+    bool showHighScore = false;
+
+    // render quality chosen by the governor
+    int   circlePoints = 30;
+    float renderScale = 1.f;
+
+    // render statistics: overlay (F3), CSV recording (F4)
+    bool showStats = false;
+    bool recordStats = false;
+};
+
+void buildRenderSnapshot(const Arena& arena, RenderSnapshot& snap);
+
+// everything only the render thread touches
+struct RenderResources {
+    sf::Texture gradient;
+    sf::RectangleShape bg;
+    sf::RectangleShape border;
+    std::vector<sf::RectangleShape> barGfx;
+    EntityGfx gfx;
+
+    // background + platforms composited once, drawn as one sprite
+    sf::RenderTexture staticLayer;
+    sf::Sprite staticSprite;
+    sf::Vector2u staticSize;
+    std::vector<Bar> staticBars;  // level the layer was built from
+
+    // world drawn at renderScale of native size, upscaled under the HUD
+    Layout ui;
+    sf::RenderTexture worldLayer;
+    sf::Sprite worldSprite;
+    sf::View worldView;
+    int circlePoints = 0;         // point count the shapes were built with
+
+    sf::Font font;
+    sf::Text scoreText, title, controls, msgText, highScoreText;
+    NumberText scoreDigits, highScoreDigits;
+    sf::Vector2f scoreNumPos, highScoreNumPos;
+    Message shownMessage = Message::None;
+
+    FrameArena frame;
+    RenderStats* stats = nullptr;   // owned by the render thread (MODULE 13)
+};
+
+void setupRenderResources(RenderResources& res, sf::RenderWindow& window, const AssetArchive& assets);
+void drawRenderSnapshot(sf::RenderWindow& window, RenderResources& res, const RenderSnapshot& snap);
+
+struct RenderThread {
+    std::thread thread;
+    std::atomic<bool> quit{ false };
+    sf::RenderWindow* window = nullptr;
+    const AssetArchive* assets = nullptr;
+    TripleBuffer<RenderSnapshot> snapshots;
+    std::atomic<float> frameMs{ 0.f };   // last frame's render work (governor)
+};
+
+void startRenderThread(RenderThread& render, sf::RenderWindow& window, const AssetArchive& assets);
+void stopRenderThread(RenderThread& render);
+
+// ==== MODULE 10: asset archive (GameAssets.cpp) =========================
+// All assets packed into one aligned file that is memory-mapped at startup
+// and handed to SFML's loadFromMemory / openFromMemory without copying.
+// Anything missing from the archive falls back to the loose file.
+
+constexpr const char* ASSET_ARCHIVE = "assets.pak";
+
+struct AssetEntry {
+    char     name[48];
+    uint64_t offset;
+    uint64_t size;
+};
+
+struct AssetArchive {
+    const unsigned char* data = nullptr;
+    size_t   size = 0;
+    uint32_t count = 0;
+    void*    file = nullptr;      // Windows handles
+    void*    mapping = nullptr;
+};
+
+bool openAssetArchive(AssetArchive& pak, const char* path);
+void closeAssetArchive(AssetArchive& pak);
+bool findAsset(const AssetArchive& pak, const char* name, const void*& data, size_t& size);
+
+bool loadAsset(sf::SoundBuffer& buffer, const AssetArchive& pak, const char* name);
+bool loadAsset(sf::Font& font, const AssetArchive& pak, const char* name);
+bool openAsset(sf::Music& music, const AssetArchive& pak, const char* name);
+bool hasAsset(const AssetArchive& pak, const char* name);
+
+int runPacker(const char* outPath, int fileCount, char** files);
+
+// ==== MODULE 11: checkpoints + run log (GameCheckpoint.cpp, GameLeaderboard.cpp)
+// The game thread copies its save state and queues it; a background thread
+// writes it to a temp file, fsyncs and renames it over the save file.
+// Finished runs go the same way into an append-only log plus a top-K index.
+
+struct SaveState {
+    int resumeScore = 0;
+    int resumeEnemies = MAX_ENEMIES;
+    int highScore = 0;
+};
+
+constexpr const char* RUN_LOG = "runs.log";
+constexpr const char* RUN_INDEX = "leaderboard.idx";
+constexpr int LEADERBOARD_K = 10;
+constexpr int MAX_QUEUED_RUNS = 16;
+
+// one finished round, fixed size so the log is just an array of these
+struct RunRecord {
+    char     player[16];
+    int32_t  score;
+    uint32_t ticks;          // duration in DT ticks
+    uint32_t kills;
+    uint32_t shots;
+    uint32_t enemiesAlive;
+    uint32_t crc;            // CRC-32 of the record with this field zeroed
+    int64_t  timestamp;      // unix seconds
+};
+
+// best K runs, highest score first, and how much of the log they cover
+struct Leaderboard {
+    RunRecord top[LEADERBOARD_K];
+    int count = 0;
+    uint64_t logBytes = 0;
+};
+
+uint32_t crc32(const void* data, size_t size);
+RunRecord makeRunRecord(const Arena& arena);
+void insertRun(Leaderboard& board, const RunRecord& run);
+bool loadLeaderboard(Leaderboard& board, const char* indexPath, const char* logPath);
+int catchUpLeaderboard(Leaderboard& board, const char* logPath, bool trimTail);
+bool appendRun(const char* logPath, const RunRecord& run);
+bool writeLeaderboardIndex(const char* indexPath, const Leaderboard& board);
+
+int runLeaderboard();                        // --leaderboard
+int runHistory(const char* player);          // --history [player]
+
+bool syncFile(std::FILE* f);
+bool writeFileAtomic(const char* path, const void* data, size_t size);
+
+struct CheckpointService {
+    std::thread thread;
+    std::mutex m;
+    std::condition_variable wake;
+    SaveState pending;             // newest unwritten request
+    bool hasPending = false;
+    FixedVector<RunRecord, MAX_QUEUED_RUNS> runs;   // unwritten finished runs
+    bool quit = false;
+    std::string path;
+
+    // checkpoint thread only; stats reported by stopCheckpoints after the join
+    Leaderboard index;             // what leaderboard.idx holds
+    uint32_t written = 0;
+    int slowestWriteMs = 0;
+};
+
+void startCheckpoints(CheckpointService& cp, const char* path, const Leaderboard& index);
+void requestCheckpoint(CheckpointService& cp, const SaveState& state);
+void recordRun(CheckpointService& cp, const RunRecord& run);
+void stopCheckpoints(CheckpointService& cp);
+bool loadCheckpoint(const char* path, SaveState& state);
+
+// ==== MODULE 12: quality governor (GameGovernor.cpp) ====================
+// Smoothed simulation and render time per frame against a target; quality
+// knobs step down quickly when over budget and back up slowly when there is
+// headroom. Every change is logged.
+
+struct QualitySettings {
+    int   subSteps = SUB_STEPS;
+    int   aiInterval = 1;
+    int   circlePoints = 30;
+    float renderScale = 1.f;
+};
+
+struct GovernorLadder {
+    int   level = 0;       // 0 = full quality
+    float avgMs = 0.f;
+    int   over = 0;        // frames in a row over budget
+    int   under = 0;       // frames in a row well under it
+    int   hold = 0;        // frames before the next move is allowed
+    int   sinceUp = -1;    // frames since a step up, -1 once it has held
+    int   backoff = 0;     // step ups reverted in a row, each doubles the wait
+};
+
+struct QualityGovernor {
+    float targetMs = DT * 1000.f;
+    GovernorLadder simLevel;
+    GovernorLadder renderLevel;
+    QualitySettings settings;
+};
+
+void setupGovernor(QualityGovernor& gov, float targetMs);
+void updateGovernor(QualityGovernor& gov, float simMs, float renderMs);
+
+// ==== MODULE 13: render statistics (GameRenderStats.cpp) ================
+// Render-thread draws go through statDraw, which counts what SFML submits
+// for them, per category. SFML does not report GL state, so binds and state
+// changes follow its own state cache: a new target resets the cache, a new
+// texture rebinds, and anything over 4 vertices loads its transform.
+
+constexpr const char* RENDER_STATS_CSV = "render_stats.csv";
+
+enum class DrawCategory : uint8_t { Background, Platforms, Enemies, Bullets, Player, HUD, Count };
+constexpr int DRAW_CATEGORIES = (int)DrawCategory::Count;
+
+struct DrawCounts {
+    uint32_t draws = 0;
+    uint32_t vertices = 0;
+    uint32_t textureBinds = 0;
+    uint32_t stateChanges = 0;
+};
+
+struct RenderStats {
+    DrawCounts frame[DRAW_CATEGORIES];   // being counted
+    DrawCounts last[DRAW_CATEGORIES];    // previous finished frame (overlay)
+    uint64_t frameIndex = 0;
+
+    // what SFML's state cache holds right now
+    const sf::RenderTarget* target = nullptr;
+    const sf::Texture* texture = nullptr;
+    bool textureKnown = false;
+
+    std::FILE* csv = nullptr;
+    bool csvFailed = false;
+
+    // overlay, built once so showing it never allocates
+    sf::RectangleShape panel;
+    sf::Text rowNames[DRAW_CATEGORIES + 1];   // categories + total
+    sf::Text columnNames[4];
+    NumberText digits;
+    sf::Vector2f cell;                        // first number, then the step
+    sf::Vector2f step;
+};
+
+void beginRenderStats(RenderStats& stats);
+void statDraw(RenderStats& stats, DrawCategory category, sf::RenderTarget& target, const sf::Shape& shape);
+void statDraw(RenderStats& stats, DrawCategory category, sf::RenderTarget& target, const sf::Sprite& sprite);
+void statDraw(RenderStats& stats, DrawCategory category, sf::RenderTarget& target, const sf::Text& text);
+
+void setupStatsOverlay(RenderStats& stats, const sf::Font& font, const Layout& ui);
+void drawStatsOverlay(sf::RenderTarget& target, RenderStats& stats, FrameArena& frame);
+
+// one CSV row per frame while recording is on; the file is closed when it goes off
+void writeRenderStats(RenderStats& stats, bool record, float frameMs, float renderScale);
+void closeRenderStats(RenderStats& stats);
+
+// ==== MODULE 14: state hashing + divergence (GameStateHash.cpp) ==========
+// Bit-exact hashes of an arena: every body's transform and velocities plus
+// the player and enemy AI state. Four independent lanes over 32-bit words,
+// so a tick's hash is a few hundred multiply-rotates.
+
+struct StateHash {
+    uint64_t lane[4];
+    uint32_t block[4];     // words waiting for a full block
+    int      buffered = 0;
+    uint64_t words = 0;
+};
+
+void beginStateHash(StateHash& h, uint64_t seed);
+void hashWords(StateHash& h, const uint32_t* words, int count);
+uint64_t endStateHash(StateHash& h);
+
+// per-entity hashes so a mismatch can be traced to one body
+struct ArenaHash {
+    uint32_t tick = 0;
+    uint64_t world = 0;
+    uint64_t player = 0;
+    uint64_t enemies[MAX_ARENA_ENEMIES];
+    int      enemyCount = 0;
+    uint64_t bullets[MAX_BULLETS];
+    int      bulletCount = 0;
+};
+
+void hashArena(const Arena& arena, ArenaHash& out);
+
+// --diverge: steps a reference arena and a variant with the same seed and
+// inputs, stops at the first tick whose hashes differ and names the entity
+//   threads    no pool vs. a worker pool (default); fails if no wave
+//              actually reached a worker. Covers the game's job graph
+//              (AI, bullets, hits); Box2D itself still steps on one
+//              thread, since worlds are made without task callbacks
+//   repeat     the same configuration twice
+//   substeps   one physics sub-step less
+//   ai         enemy AI every second tick
+int runDivergence(const char* variant, int ticks, int threads, int enemies = MAX_ARENA_ENEMIES);
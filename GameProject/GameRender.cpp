@@ -0,0 +1,368 @@
+﻿#include "GameProject.hpp"
+
+// world part of the snapshot (HUD fields are filled by the caller)
+void buildRenderSnapshot(const Arena& arena, RenderSnapshot& snap)
+{
+    const Player& player = arena.player;
+
+    snap.tick = arena.tick;
+
+    snap.enemyCount = 0;
+    for (const auto& e : arena.enemies)
+    {
+        if (!e.alive) continue;
+        RenderSprite& s = snap.enemies[snap.enemyCount++];
+        s.pos = b2Body_GetPosition(e.id);
+        s.color = e.color;
+    }
+
+    snap.bulletCount = 0;
+    for (const auto& b : arena.bullets)
+        snap.bullets[snap.bulletCount++] = b2Body_GetPosition(b.id);
+
+    snap.player = b2Body_GetPosition(player.id);
+    snap.playerDir = player.dir;
+    snap.muzzle = player.muzzleTimer > 0.f;
+    snap.score = player.score;
+}
+
+// Gradient and platforms never move, so they are drawn into one texture and
+// rebuilt only when the window size or the level changes. The pulsing
+// border stays a separate outline drawn on top.
+static void layoutText(RenderResources& res);
+
+// levelBars() hands out the same vector whatever it holds, so the layout
+// itself is the cache key, not its address
+static bool sameBars(const std::vector<Bar>& a, const std::vector<Bar>& b)
+{
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const Bar& x, const Bar& y)
+        {
+            return x.cx == y.cx && x.cy == y.cy && x.hx == y.hx && x.hy == y.hy;
+        });
+}
+
+static void refreshStaticLayer(RenderResources& res, const sf::RenderWindow& window, const std::vector<Bar>& bars)
+{
+    sf::Vector2u size = window.getSize();
+    if (size == res.staticSize && sameBars(bars, res.staticBars))
+        return;
+
+    if (size != res.staticSize)
+    {
+        // both layers cover the letterboxed logical area at native pixels
+        res.ui = makeLayout(size);
+        unsigned w = (unsigned)std::lround(LOGICAL_W * res.ui.scale);
+        unsigned h = (unsigned)std::lround(LOGICAL_H * res.ui.scale);
+
+        if (!res.staticLayer.create(w, h) || !res.worldLayer.create(w, h))
+            std::cout << "Failed to create " << w << "x" << h << " render layers\n";
+
+        res.staticLayer.setView(sf::View(sf::FloatRect(0.f, 0.f, LOGICAL_W, LOGICAL_H)));
+        res.worldLayer.setSmooth(true);
+        res.worldView.reset(sf::FloatRect(0.f, 0.f, LOGICAL_W, LOGICAL_H));
+        res.worldSprite.setTexture(res.worldLayer.getTexture());
+        layoutText(res);
+    }
+    setupArenaGfx(res.border, bars, res.barGfx);
+
+    // counted in the frame that rebuilds it
+    RenderStats& stats = *res.stats;
+    res.staticLayer.clear();
+    statDraw(stats, DrawCategory::Background, res.staticLayer, res.bg);
+    for (auto& r : res.barGfx)
+        statDraw(stats, DrawCategory::Platforms, res.staticLayer, r);
+    res.staticLayer.display();
+
+    // sprite spans the logical area whatever the texture size
+    sf::Vector2u texSize = res.staticLayer.getSize();
+    res.staticSprite.setTexture(res.staticLayer.getTexture(), true);
+    res.staticSprite.setScale(LOGICAL_W / texSize.x, LOGICAL_H / texSize.y);
+    res.staticSize = size;
+    res.staticBars = bars;
+}
+
+// character sizes and positions all scale with res.ui, so every text is
+// laid out again whenever the window size changes
+static void layoutText(RenderResources& res)
+{
+    const Layout& ui = res.ui;
+    setupText(res.font, res.scoreText, res.title, res.controls, res.msgText, ui);
+
+    // Controls text with save / load / high-score info
+    res.controls.setString(
+        "LEFT Arrow - Move Left    SPACE - Jump\n"
+        "RIGHT Arrow - Move Right   S - Shoot\n"
+        "R - Restart                ENTER - Start\n"
+        "CTRL+S - Save   CTRL+D - High Score\n"
+        "O - Open Save (if available)"
+    );
+    centerTextX(res.controls);
+
+    // High score text (shown with CTRL+D)
+    sf::Text& hs = res.highScoreText;
+    hs.setFont(res.font);
+    hs.setCharacterSize((unsigned)std::lround(32 * ui.scale));
+    hs.setFillColor(sf::Color::Yellow);
+    hs.setOutlineColor(sf::Color::Black);
+    hs.setOutlineThickness(2 * ui.scale);
+    hs.setPosition(toScreen(ui, { 30.f, 70.f }));
+    hs.setString("High Score: ");
+
+    // numbers are drawn digit by digit after their labels
+    setupNumberText(res.scoreDigits, res.font, res.scoreText);
+    setupNumberText(res.highScoreDigits, res.font, hs);
+    res.scoreNumPos = res.scoreText.findCharacterPos(res.scoreText.getString().getSize());
+    res.highScoreNumPos = hs.findCharacterPos(hs.getString().getSize());
+
+    setupStatsOverlay(*res.stats, res.font, ui);
+
+    // setupText cleared the message; updateMessage sets and places it again
+    res.shownMessage = Message::None;
+}
+
+// Background, arena, shapes and text (runs on the render thread)
+void setupRenderResources(RenderResources& res, sf::RenderWindow& window, const AssetArchive& assets)
+{
+    setupBackground(res.bg, res.gradient);
+    setupEntityGfx(res.gfx);
+    if (!loadAsset(res.font, assets, "arial.ttf"))
+        std::cout << "Failed to load arial.ttf\n";
+
+    // builds the layers and lays out the text for the current size
+    refreshStaticLayer(res, window, levelBars());
+
+    initFrameArena(res.frame, 64 * 1024);
+}
+
+// message text only changes when the message does
+static void updateMessage(RenderResources& res, Message message)
+{
+    if (message == res.shownMessage)
+        return;
+    res.shownMessage = message;
+
+    sf::Text& msg = res.msgText;
+    switch (message)
+    {
+    case Message::GameOver:
+        msg.setString("GAME OVER — Press R to Restart");
+        msg.setFillColor(sf::Color::Red);
+        break;
+    case Message::Won:
+        msg.setString("YOU WIN! Press R to Play Again");
+        msg.setFillColor(sf::Color::Green);
+        break;
+    case Message::Saved:
+        msg.setString("Game saved. You can load it with O next time.");
+        msg.setFillColor(sf::Color::White);
+        break;
+    case Message::None:
+        return;
+    }
+    centerTextX(msg);
+    msg.setPosition(toScreen(res.ui, { LOGICAL_W / 2.f, LOGICAL_H / 2.f }));
+}
+
+// arena, entities and border in logical units
+static void drawWorld(sf::RenderTarget& target, RenderResources& res, const RenderSnapshot& snap)
+{
+    RenderStats& stats = *res.stats;
+    statDraw(stats, DrawCategory::Background, target, res.staticSprite);
+
+    EntityGfx& gfx = res.gfx;
+    for (int i = 0; i < snap.enemyCount; ++i)
+    {
+        gfx.enemy.setFillColor(snap.enemies[i].color);
+        gfx.enemy.setPosition(toSFML(snap.enemies[i].pos));
+        statDraw(stats, DrawCategory::Enemies, target, gfx.enemy);
+    }
+
+    for (int i = 0; i < snap.bulletCount; ++i)
+    {
+        gfx.bullet.setPosition(toSFML(snap.bullets[i]));
+        statDraw(stats, DrawCategory::Bullets, target, gfx.bullet);
+    }
+
+    // Player + gun + muzzle
+    PlayerGfx& pg = gfx.player;
+    sf::Vector2f playerPix = toSFML(snap.player);
+    pg.body.setPosition(playerPix);
+
+    float gunOffset = pg.body.getRadius() + 10.f;
+    sf::Vector2f gunPos = playerPix;
+    gunPos.x += snap.playerDir * gunOffset;
+    pg.gun.setPosition(gunPos);
+    pg.gun.setRotation(snap.playerDir > 0.f ? 0.f : 180.f);
+
+    statDraw(stats, DrawCategory::Player, target, pg.body);
+    statDraw(stats, DrawCategory::Player, target, pg.gun);
+
+    if (snap.muzzle)
+    {
+        float muzzleOffset = gunOffset + pg.gun.getSize().x * 0.6f;
+        sf::Vector2f muzzlePos = playerPix;
+        muzzlePos.x += snap.playerDir * muzzleOffset;
+        pg.muzzle.setPosition(muzzlePos);
+        statDraw(stats, DrawCategory::Player, target, pg.muzzle);
+    }
+
+    // the pulsing border counts with the platforms as arena geometry
+    res.border.setOutlineColor(sf::Color(0, 255, 220, snap.borderAlpha));
+    statDraw(stats, DrawCategory::Platforms, target, res.border);
+}
+
+// circle smoothness is a governor knob; bullets are tiny, so fewer points
+static void updateCirclePoints(RenderResources& res, int points)
+{
+    if (points == res.circlePoints)
+        return;
+    res.circlePoints = points;
+
+    EntityGfx& gfx = res.gfx;
+    gfx.player.body.setPointCount(points);
+    gfx.player.muzzle.setPointCount(points);
+    gfx.enemy.setPointCount(points);
+    gfx.bullet.setPointCount(std::max(8, points / 2));
+}
+
+static void drawHud(sf::RenderWindow& window, RenderResources& res, const RenderSnapshot& snap)
+{
+    RenderStats& stats = *res.stats;
+    const DrawCategory hud = DrawCategory::HUD;
+
+    // TITLE SCREEN
+    if (snap.screen == Screen::Title)
+    {
+        res.title.setFillColor(sf::Color(0, 255, 180, snap.titleAlpha));
+        statDraw(stats, hud, window, res.title);
+        statDraw(stats, hud, window, res.controls);
+
+        if (snap.showHighScore)
+        {
+            statDraw(stats, hud, window, res.highScoreText);
+            drawNumber(window, res.highScoreDigits,
+                frameFormat(res.frame, "%d", snap.highScore), res.highScoreNumPos, &stats);
+        }
+        return;
+    }
+
+    // SAVED SCREEN
+    if (snap.screen == Screen::Saved)
+    {
+        statDraw(stats, hud, window, res.msgText);
+        return;
+    }
+
+    statDraw(stats, hud, window, res.scoreText);
+    drawNumber(window, res.scoreDigits, frameFormat(res.frame, "%d", snap.score), res.scoreNumPos, &stats);
+
+    // High-score overlay (CTRL+D)
+    if (snap.showHighScore)
+    {
+        statDraw(stats, hud, window, res.highScoreText);
+        drawNumber(window, res.highScoreDigits,
+            frameFormat(res.frame, "%d", snap.highScore), res.highScoreNumPos, &stats);
+    }
+
+    if (snap.message != Message::None)
+        statDraw(stats, hud, window, res.msgText);
+}
+
+void drawRenderSnapshot(sf::RenderWindow& window, RenderResources& res, const RenderSnapshot& snap)
+{
+    resetFrameArena(res.frame);
+    RenderStats& stats = *res.stats;
+    beginRenderStats(stats);
+    refreshStaticLayer(res, window, levelBars());
+    updateMessage(res, snap.message);
+    updateCirclePoints(res, snap.circlePoints);
+
+    // WORLD PASS: only the top-left renderScale part of the layer is used
+    sf::RenderTexture& world = res.worldLayer;
+    float s = std::max(RENDER_SCALE_MIN, std::min(1.f, snap.renderScale));
+    res.worldView.setViewport(sf::FloatRect(0.f, 0.f, s, s));
+    world.setView(res.worldView);
+    world.clear();
+    if (snap.screen == Screen::Playing)
+        drawWorld(world, res, snap);
+    else
+        statDraw(stats, DrawCategory::Background, world, res.bg);
+    world.display();
+
+    // stretch that part over the letterboxed window area
+    sf::Vector2u full = world.getSize();
+    sf::IntRect used(0, 0,
+        std::max(1, (int)std::lround(full.x * s)),
+        std::max(1, (int)std::lround(full.y * s)));
+    res.worldSprite.setTextureRect(used);
+    res.worldSprite.setScale((float)full.x / used.width, (float)full.y / used.height);
+    res.worldSprite.setPosition(res.ui.origin);
+
+    // the upscale is the last step of drawing the world, so it counts there
+    window.clear();
+    statDraw(stats, DrawCategory::Background, window, res.worldSprite);
+
+    // HUD PASS: native resolution, so text stays sharp at any renderScale
+    drawHud(window, res, snap);
+
+    // DEBUG OVERLAY (F3): last frame's counts, on top of everything
+    if (snap.showStats)
+        drawStatsOverlay(window, stats, res.frame);
+}
+
+static void renderThreadMain(RenderThread* render)
+{
+    sf::RenderWindow& window = *render->window;
+    window.setActive(true);
+
+    // counters + overlay; res.stats points here for every draw
+    RenderStats stats;
+    RenderResources res;
+    res.stats = &stats;
+    setupRenderResources(res, window, *render->assets);
+
+    AllocReport allocs;
+    allocs.label = "render";
+
+    // paced here instead of with setFramerateLimit, so the measured time is
+    // the frame's own work and not the limiter's sleep
+    const float frameMs = DT * 1000.f;
+    sf::Clock frameClock;
+
+    while (!render->quit.load(std::memory_order_acquire))
+    {
+        frameClock.restart();
+
+        trackFrameAllocs(allocs);
+        const RenderSnapshot& snap = render->snapshots.read();
+        drawRenderSnapshot(window, res, snap);
+        window.display();
+
+        // the governor (sim thread) turns this into renderScale / circlePoints
+        float workMs = frameClock.getElapsedTime().asMicroseconds() / 1000.f;
+        render->frameMs.store(workMs, std::memory_order_relaxed);
+        writeRenderStats(stats, snap.recordStats, workMs, snap.renderScale);
+        if (workMs < frameMs)
+            sf::sleep(sf::microseconds((sf::Int64)((frameMs - workMs) * 1000.f)));
+    }
+
+    closeRenderStats(stats);
+    window.setActive(false);
+}
+
+// the window stays with the calling thread for events; only drawing moves
+void startRenderThread(RenderThread& render, sf::RenderWindow& window, const AssetArchive& assets)
+{
+    render.window = &window;
+    render.assets = &assets;
+    render.quit = false;
+    window.setActive(false);
+    render.thread = std::thread(renderThreadMain, &render);
+}
+
+void stopRenderThread(RenderThread& render)
+{
+    render.quit = true;
+    if (render.thread.joinable())
+        render.thread.join();
+}
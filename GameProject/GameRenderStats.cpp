@@ -0,0 +1,227 @@
+#include "GameProject.hpp"
+
+static const char* const categoryNames[DRAW_CATEGORIES] = {
+    "background", "platforms", "enemies", "bullets", "player", "hud"
+};
+
+static const char* const columnLabels[4] = { "draws", "verts", "binds", "states" };
+
+void beginRenderStats(RenderStats& stats)
+{
+    for (int c = 0; c < DRAW_CATEGORIES; ++c)
+    {
+        stats.last[c] = stats.frame[c];
+        stats.frame[c] = DrawCounts{};
+    }
+    ++stats.frameIndex;
+}
+
+// one RenderTarget::draw(vertices) as SFML issues it
+static void countCall(RenderStats& stats, DrawCategory category, const sf::RenderTarget& target,
+    const sf::Texture* texture, uint32_t vertices)
+{
+    if (vertices == 0)
+        return;   // SFML returns before touching any state
+
+    DrawCounts& c = stats.frame[(int)category];
+    ++c.draws;
+    c.vertices += vertices;
+
+    // switching targets activates another context and resets the cache
+    if (&target != stats.target)
+    {
+        stats.target = &target;
+        stats.textureKnown = false;
+        ++c.stateChanges;
+    }
+    if (!stats.textureKnown || texture != stats.texture)
+    {
+        stats.texture = texture;
+        stats.textureKnown = true;
+        ++c.textureBinds;
+        ++c.stateChanges;
+    }
+
+    // up to 4 vertices are pre-transformed on the CPU, more load the matrix
+    if (vertices > 4)
+        ++c.stateChanges;
+}
+
+// fill as a triangle fan, outline as a strip in a second untextured call
+void statDraw(RenderStats& stats, DrawCategory category, sf::RenderTarget& target, const sf::Shape& shape)
+{
+    uint32_t points = (uint32_t)shape.getPointCount();
+    countCall(stats, category, target, shape.getTexture(), points + 2);
+    if (shape.getOutlineThickness() != 0.f)
+        countCall(stats, category, target, nullptr, (points + 1) * 2);
+    target.draw(shape);
+}
+
+void statDraw(RenderStats& stats, DrawCategory category, sf::RenderTarget& target, const sf::Sprite& sprite)
+{
+    countCall(stats, category, target, sprite.getTexture(), 4);
+    target.draw(sprite);
+}
+
+// two triangles per visible glyph, outline first in its own call
+void statDraw(RenderStats& stats, DrawCategory category, sf::RenderTarget& target, const sf::Text& text)
+{
+    const sf::Font* font = text.getFont();
+    if (font)
+    {
+        const sf::String& str = text.getString();
+        uint32_t glyphs = 0;
+        for (std::size_t i = 0; i < str.getSize(); ++i)
+            if (str[i] != ' ' && str[i] != '\t' && str[i] != '\n')
+                ++glyphs;
+
+        const sf::Texture* page = &font->getTexture(text.getCharacterSize());
+        if (text.getOutlineThickness() != 0.f)
+            countCall(stats, category, target, page, glyphs * 6);
+        countCall(stats, category, target, page, glyphs * 6);
+    }
+    target.draw(text);
+}
+
+// Table in the top-right corner: one row per category plus the total
+void setupStatsOverlay(RenderStats& stats, const sf::Font& font, const Layout& ui)
+{
+    const float rowH = 26.f;
+    const float colW = 110.f;
+    sf::Vector2f corner(LOGICAL_W - 620.f, 20.f);
+
+    stats.panel.setSize(sf::Vector2f(600.f, (DRAW_CATEGORIES + 2) * rowH + 20.f) * ui.scale);
+    stats.panel.setPosition(toScreen(ui, corner));
+    stats.panel.setFillColor(sf::Color(0, 0, 0, 170));
+
+    sf::Text style;
+    style.setFont(font);
+    style.setCharacterSize((unsigned)std::lround(18 * ui.scale));
+    style.setFillColor(sf::Color::White);
+
+    for (int c = 0; c < 4; ++c)
+    {
+        stats.columnNames[c] = style;
+        stats.columnNames[c].setString(columnLabels[c]);
+        stats.columnNames[c].setPosition(toScreen(ui, corner + sf::Vector2f(150.f + c * colW, 10.f)));
+    }
+    for (int r = 0; r <= DRAW_CATEGORIES; ++r)
+    {
+        stats.rowNames[r] = style;
+        stats.rowNames[r].setString(r < DRAW_CATEGORIES ? categoryNames[r] : "total");
+        stats.rowNames[r].setPosition(toScreen(ui, corner + sf::Vector2f(10.f, 10.f + (r + 1) * rowH)));
+    }
+    stats.rowNames[DRAW_CATEGORIES].setFillColor(sf::Color::Yellow);
+
+    setupNumberText(stats.digits, font, style);
+    stats.cell = toScreen(ui, corner + sf::Vector2f(150.f, 10.f + rowH));
+    stats.step = sf::Vector2f(colW, rowH) * ui.scale;
+}
+
+static void drawCountsRow(sf::RenderTarget& target, RenderStats& stats, FrameArena& frame,
+    const DrawCounts& c, int row)
+{
+    const uint32_t values[4] = { c.draws, c.vertices, c.textureBinds, c.stateChanges };
+    for (int col = 0; col < 4; ++col)
+    {
+        sf::Vector2f pos(stats.cell.x + col * stats.step.x, stats.cell.y + row * stats.step.y);
+        drawNumber(target, stats.digits, frameFormat(frame, "%u", values[col]), pos);
+    }
+}
+
+// previous frame's numbers; the overlay's own draws are not counted
+void drawStatsOverlay(sf::RenderTarget& target, RenderStats& stats, FrameArena& frame)
+{
+    target.draw(stats.panel);
+    for (const sf::Text& t : stats.columnNames)
+        target.draw(t);
+    for (const sf::Text& t : stats.rowNames)
+        target.draw(t);
+
+    DrawCounts total;
+    for (int c = 0; c < DRAW_CATEGORIES; ++c)
+    {
+        const DrawCounts& d = stats.last[c];
+        drawCountsRow(target, stats, frame, d, c);
+        total.draws += d.draws;
+        total.vertices += d.vertices;
+        total.textureBinds += d.textureBinds;
+        total.stateChanges += d.stateChanges;
+    }
+    drawCountsRow(target, stats, frame, total, DRAW_CATEGORIES);
+
+    // it changed SFML's bound texture behind the counters' back
+    stats.textureKnown = false;
+}
+
+static bool openStatsCsv(RenderStats& stats)
+{
+    stats.csv = openFile(RENDER_STATS_CSV, "a");
+    if (!stats.csv)
+        return false;
+
+    // a new file gets the header; later recordings append below it
+    std::fseek(stats.csv, 0, SEEK_END);
+    if (std::ftell(stats.csv) == 0)
+    {
+        std::fprintf(stats.csv, "frame,ms,scale");
+        for (int c = 0; c <= DRAW_CATEGORIES; ++c)
+        {
+            const char* name = c < DRAW_CATEGORIES ? categoryNames[c] : "total";
+            for (const char* col : columnLabels)
+                std::fprintf(stats.csv, ",%s_%s", name, col);
+        }
+        std::fprintf(stats.csv, "\n");
+    }
+    return true;
+}
+
+// called after the frame is drawn, so frame[] is complete
+void writeRenderStats(RenderStats& stats, bool record, float frameMs, float renderScale)
+{
+    if (!record)
+    {
+        closeRenderStats(stats);
+        stats.csvFailed = false;
+        return;
+    }
+
+    if (!stats.csv)
+    {
+        if (stats.csvFailed)
+            return;   // said so once, wait for the next F4
+        if (!openStatsCsv(stats))
+        {
+            std::cout << "Failed to open " << RENDER_STATS_CSV << "\n";
+            stats.csvFailed = true;
+            return;
+        }
+        std::cout << "Recording render stats to " << RENDER_STATS_CSV << "\n";
+    }
+
+    std::FILE* f = stats.csv;
+    std::fprintf(f, "%llu,%.3f,%.2f", (unsigned long long)stats.frameIndex, frameMs, renderScale);
+
+    DrawCounts total;
+    for (int c = 0; c <= DRAW_CATEGORIES; ++c)
+    {
+        const DrawCounts& d = c < DRAW_CATEGORIES ? stats.frame[c] : total;
+        std::fprintf(f, ",%u,%u,%u,%u", d.draws, d.vertices, d.textureBinds, d.stateChanges);
+        if (c == DRAW_CATEGORIES)
+            break;
+        total.draws += d.draws;
+        total.vertices += d.vertices;
+        total.textureBinds += d.textureBinds;
+        total.stateChanges += d.stateChanges;
+    }
+    std::fprintf(f, "\n");
+}
+
+void closeRenderStats(RenderStats& stats)
+{
+    if (!stats.csv)
+        return;
+    std::fclose(stats.csv);
+    stats.csv = nullptr;
+    std::cout << "Render stats saved to " << RENDER_STATS_CSV << "\n";
+}
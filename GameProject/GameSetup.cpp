@@ -1,5 +1,34 @@
 #include "GameProject.hpp"
 
+// Hits are distance checks in stepArena, so bullets and enemies never need
+// a physical contact with each other or the player; enemies pass through
+// each other instead of piling up. Everything still lands on the level.
+bool collisionMatrix[CAT_COUNT][CAT_COUNT] = {
+    //            static  player enemy  bullet sensor
+    /* static */ { false, true,  true,  true,  false },
+    /* player */ { true,  false, false, false, true  },
+    /* enemy  */ { true,  false, false, false, true  },
+    /* bullet */ { true,  false, false, false, false },
+    /* sensor */ { false, true,  true,  false, false },
+};
+
+void setCollision(CollisionCategory a, CollisionCategory b, bool collide)
+{
+    collisionMatrix[a][b] = collide;
+    collisionMatrix[b][a] = collide;
+}
+
+b2Filter collisionFilter(CollisionCategory category)
+{
+    b2Filter filter = b2DefaultFilter();
+    filter.categoryBits = 1ull << category;
+    filter.maskBits = 0;
+    for (int other = 0; other < CAT_COUNT; ++other)
+        if (collisionMatrix[category][other])
+            filter.maskBits |= 1ull << other;
+    return filter;
+}
+
 void addStaticBox(b2WorldId world, float cx, float cy, float hx, float hy)
 {
     b2BodyDef bd = b2DefaultBodyDef();
@@ -8,6 +37,7 @@ void addStaticBox(b2WorldId world, float cx, float cy, float hx, float hy)
 
     b2Polygon box = b2MakeBox(hx, hy);
     b2ShapeDef sd = b2DefaultShapeDef();
+    sd.filter = collisionFilter(CAT_STATIC);
     b2CreatePolygonShape(body, &sd, &box);
 }
 
@@ -36,17 +66,19 @@ bool isGrounded(const b2Vec2& pos, float radius, const std::vector<Bar>& bars)
     return false;
 }
 
-// gradient background  
-void setupWindowAndBackground(
-    sf::RenderWindow& window,
+// gradient background (logical size, stretched smoothly to the window)
+void setupBackground(
     sf::RectangleShape& bg,
     sf::Texture& gradient)
 {
+    const unsigned w = (unsigned)LOGICAL_W;
+    const unsigned h = (unsigned)LOGICAL_H;
+
     sf::Image img;
-    img.create(window.getSize().x, window.getSize().y);
-    for (unsigned y = 0; y < window.getSize().y; ++y)
+    img.create(w, h);
+    for (unsigned y = 0; y < h; ++y)
     {
-        for (unsigned x = 0; x < window.getSize().x; ++x)
+        for (unsigned x = 0; x < w; ++x)
         {
             img.setPixel(
                 x, y,
@@ -60,17 +92,29 @@ void setupWindowAndBackground(
     }
 
     gradient.loadFromImage(img);
-    bg.setSize(sf::Vector2f(window.getSize().x, window.getSize().y));
+    gradient.setSmooth(true);
+    bg.setSize(sf::Vector2f(LOGICAL_W, LOGICAL_H));
     bg.setTexture(&gradient);
 }
 
-// world, walls, border and platforms  e
+// platform layout shared by the server, the client and the local game
+const std::vector<Bar>& levelBars()
+{
+    static const std::vector<Bar> bars = {
+        { 0.f, -5.f, 12.f, 0.4f },
+        { 8.f, 0.f, 6.f, 0.4f },
+        { -10.f, 4.f, 8.f, 0.4f },
+        { 0.f, 7.f, 10.f, 0.4f },
+        { -15.f, -2.f, 5.f, 0.4f },
+        { 14.f, 3.f, 5.f, 0.4f },
+    };
+    return bars;
+}
+
+// world, walls and platforms (physics only)
 void setupWorldAndArena(
     b2WorldId& world,
-    sf::RectangleShape& border,
-    std::vector<Bar>& bars,
-    std::vector<sf::RectangleShape>& barGfx,
-    const sf::RenderWindow& window)
+    std::vector<Bar>& bars)
 {
     // Box2D world
     b2WorldDef wd = b2DefaultWorldDef();
@@ -83,31 +127,28 @@ void setupWorldAndArena(
     addStaticBox(world, WORLD_LEFT - 0.5f, 0.f, 0.5f, 12.f);  // left wall
     addStaticBox(world, WORLD_RIGHT + 0.5f, 0.f, 0.5f, 12.f); // right wall
 
+    // Platforms (bars)
+    bars = levelBars();
+    for (const auto& b : bars)
+        addStaticBox(world, b.cx, b.cy, b.hx, b.hy);
+}
+
+// border and platform graphics
+void setupArenaGfx(
+    sf::RectangleShape& border,
+    const std::vector<Bar>& bars,
+    std::vector<sf::RectangleShape>& barGfx)
+{
     // Border
     border.setSize({
         (WORLD_RIGHT - WORLD_LEFT + 1.f) * PX,
         (WORLD_CEIL - WORLD_FLOOR + 1.f) * PX
         });
     border.setOrigin(border.getSize() / 2.f);
-    border.setPosition(window.getSize().x / 2.f, window.getSize().y / 2.f);
+    border.setPosition(LOGICAL_W / 2.f, LOGICAL_H / 2.f);
     border.setFillColor(sf::Color::Transparent);
     border.setOutlineThickness(10.f);
 
-    // Platforms (bars)
-    bars.clear();
-    auto addBar = [&](float cx, float cy, float hx, float hy)
-        {
-            addStaticBox(world, cx, cy, hx, hy);
-            bars.push_back({ cx, cy, hx, hy });
-        };
-
-    addBar(0.f, -5.f, 12.f, 0.4f);
-    addBar(8.f, 0.f, 6.f, 0.4f);
-    addBar(-10.f, 4.f, 8.f, 0.4f);
-    addBar(0.f, 7.f, 10.f, 0.4f);
-    addBar(-15.f, -2.f, 5.f, 0.4f);
-    addBar(14.f, 3.f, 5.f, 0.4f);
-
     barGfx.clear();
     for (const auto& b : bars)
     {
@@ -117,7 +158,7 @@ void setupWorldAndArena(
         r.setFillColor(sf::Color(130, 90, 255, 220));
         r.setOutlineThickness(2);
         r.setOutlineColor(sf::Color(190, 140, 255, 180));
-        r.setPosition(toSFML({ b.cx, b.cy }, window));
+        r.setPosition(toSFML({ b.cx, b.cy }));
         barGfx.push_back(r);
     }
 }
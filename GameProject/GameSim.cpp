@@ -0,0 +1,401 @@
+#include "GameProject.hpp"
+
+
+// world, player and first wave of enemies
+void setupArena(Arena& arena, unsigned seed, int enemyCap)
+{
+    arena.seed = seed;
+    arena.nextEnemyId = 0;
+    arena.enemyCap = std::max(0, enemyCap);
+
+    setupWorldAndArena(arena.world, arena.bars);
+    setupPlayer(arena.player, arena.world);
+
+    resetArena(arena, arena.enemyCap, 0);
+}
+
+// new round in the same world (restart, resume, server rematch)
+void resetArena(Arena& arena, int enemyCount, int score)
+{
+    // Destroy old enemies
+    for (auto& e : arena.enemies)
+    {
+        if (e.alive)
+            b2DestroyBody(e.id);
+    }
+    arena.enemies.clear();
+
+    // Destroy bullets
+    for (auto& b : arena.bullets)
+        b2DestroyBody(b.id);
+    arena.bullets.clear();
+
+    // Reset player
+    Player& player = arena.player;
+    player.score = score;
+    player.jumps = 2;
+    player.dir = 1.f;
+    player.shootCD = 0.f;
+    player.muzzleTimer = 0.f;
+
+    b2Vec2 resetPos = { 0.f, WORLD_FLOOR + 2.f };
+    b2Body_SetTransform(player.id, resetPos, { 1.f, 0.f });
+    b2Body_SetLinearVelocity(player.id, { 0.f, 0.f });
+
+    arena.prevJump = false;
+    arena.gameOver = false;
+    arena.playerWon = false;
+    arena.events = {};
+    arena.stats = {};
+
+    // Respawn enemies
+    int toSpawn = std::max(0, std::min(enemyCount, arena.enemyCap));
+    for (int i = 0; i < toSpawn; ++i)
+        spawnEnemy(arena.enemies, arena.world, arena.seed, arena.nextEnemyId++, arena.enemyCap);
+}
+
+// STEP JOBS
+// Parallel jobs only read Box2D and write their own entity's slot in
+// arena.frame; anything that changes the world (velocities, the step,
+// destroying bodies) happens in the single-range jobs, in index order.
+
+// desired velocity for each enemy: track the player, pick a side, jump up
+static void aiJob(void* ctx, int begin, int end)
+{
+    Arena& arena = *static_cast<Arena*>(ctx);
+    ArenaFrame& f = arena.frame;
+    b2Vec2 pPos = f.playerPos;
+    float dt = DT * std::max(1, arena.aiInterval);   // time since the last AI run
+
+    for (int i = begin; i < end; ++i)
+    {
+        Enemy& en = arena.enemies[i];
+        if (!en.alive) continue;
+
+        b2Vec2 ePos = b2Body_GetPosition(en.id);
+        b2Vec2 eVel = b2Body_GetLinearVelocity(en.id);
+
+        // this enemy's numbers for this tick
+        RandomBlock r = philox(arena.seed, en.uid, arena.tick, RNG_AI, 0);
+
+        // update timers
+        en.pathTimer -= dt;
+        en.jumpCooldown -= dt;
+        if (en.jumpCooldown < 0.f) en.jumpCooldown = 0.f;
+
+        // occasionally change which side they prefer (random path)
+        if (en.pathTimer <= 0.f)
+        {
+            en.sideBias = (r.v[0] & 1) ? 1.f : -1.f;
+            en.pathTimer = randomRange(r.v[1], 1.f, 3.f);
+        }
+
+        // horizontal target: a little left or right of the player
+        float targetX = pPos.x + en.sideBias * 2.5f;
+        float dx = targetX - ePos.x;
+
+        if (dx > 0.15f)
+            eVel.x = en.speed;
+        else if (dx < -0.15f)
+            eVel.x = -en.speed;
+        else
+            // small damping when roughly at target side
+            eVel.x *= 0.8f;
+
+        // jumping: if player is above and enemy is near horizontally
+        float horizToPlayer = std::fabs(pPos.x - ePos.x);
+        bool enemyGrounded = isGrounded(ePos, en.radius, arena.bars);
+
+        if (enemyGrounded &&
+            en.jumpCooldown == 0.f &&
+            pPos.y > ePos.y + 1.f &&
+            horizToPlayer < 4.f)
+        {
+            eVel.y = 10.f;
+            // jump up towards player stage
+            en.jumpCooldown = randomRange(r.v[2], 0.8f, 1.8f);
+        }
+
+        f.enemyVel[i] = eVel;
+    }
+}
+
+// apply the AI, then the physics step (single range)
+static void physicsJob(void* ctx, int, int)
+{
+    Arena& arena = *static_cast<Arena*>(ctx);
+
+    if (arena.frame.aiRan)
+        for (int i = 0; i < (int)arena.enemies.size(); ++i)
+            if (arena.enemies[i].alive)
+                b2Body_SetLinearVelocity(arena.enemies[i].id, arena.frame.enemyVel[i]);
+
+    b2World_Step(arena.world, DT, arena.subSteps);
+
+    // MUZZLE TIMER
+    Player& player = arena.player;
+    if (player.muzzleTimer > 0.f)
+        player.muzzleTimer -= DT;
+
+    arena.frame.playerAfter = b2Body_GetPosition(player.id);
+}
+
+// bullet lifetimes and positions
+static void bulletJob(void* ctx, int begin, int end)
+{
+    Arena& arena = *static_cast<Arena*>(ctx);
+    for (int i = begin; i < end; ++i)
+    {
+        Bullet& b = arena.bullets[i];
+        b.life -= DT;
+        if (b.life > 0.f)
+            arena.frame.bulletPos[i] = b2Body_GetPosition(b.id);
+    }
+}
+
+// per enemy: touched by a live bullet? touching the player?
+// (bullet hit radius is the old 8 px slack, in meters)
+static void hitJob(void* ctx, int begin, int end)
+{
+    Arena& arena = *static_cast<Arena*>(ctx);
+    ArenaFrame& f = arena.frame;
+    float playerR = arena.player.radius;
+
+    for (int i = begin; i < end; ++i)
+    {
+        const Enemy& en = arena.enemies[i];
+        f.enemyHit[i] = false;
+        f.enemyTouch[i] = false;
+        if (!en.alive) continue;
+
+        b2Vec2 ep = b2Body_GetPosition(en.id);
+        for (int b = 0; b < (int)arena.bullets.size(); ++b)
+        {
+            if (arena.bullets[b].life > 0.f &&
+                b2Distance(ep, f.bulletPos[b]) < en.radius + 8.f / PX)
+            {
+                f.enemyHit[i] = true;
+                break;
+            }
+        }
+
+        // slightly larger than sum of radii so "little collision" also kills
+        f.enemyTouch[i] = b2Distance(ep, f.playerAfter) < playerR + en.radius + 6.f / PX;
+    }
+}
+
+// apply hits in index order (single range)
+static void resolveJob(void* ctx, int, int)
+{
+    Arena& arena = *static_cast<Arena*>(ctx);
+    ArenaFrame& f = arena.frame;
+    Player& player = arena.player;
+
+    // expired bullets
+    for (auto it = arena.bullets.begin(); it != arena.bullets.end();)
+    {
+        if (it->life <= 0.f)
+        {
+            b2DestroyBody(it->id);
+            it = arena.bullets.erase(it);
+            continue;
+        }
+        ++it;
+    }
+
+    for (int i = 0; i < (int)arena.enemies.size(); ++i)
+    {
+        Enemy& en = arena.enemies[i];
+        if (!en.alive) continue;
+
+        if (f.enemyHit[i])
+        {
+            en.alive = false;
+            player.score += en.scoreValue;
+            b2DestroyBody(en.id);
+            arena.events.enemyKilled = true;
+            ++arena.stats.kills;
+        }
+        else if (f.enemyTouch[i] && !arena.gameOver)
+        {
+            // PLAYER HIT
+            arena.events.playerDied = true;
+            arena.gameOver = true;
+        }
+    }
+
+    // WIN CONDITION
+    if (std::all_of(
+        arena.enemies.begin(), arena.enemies.end(),
+        [](const Enemy& e) { return !e.alive; }))
+    {
+        arena.playerWon = true;
+    }
+}
+
+// one fixed DT tick: input, AI, physics, bullets, hits
+void stepArena(Arena& arena, const PlayerInput& input)
+{
+    arena.events = {};
+    if (arena.gameOver || arena.playerWon)
+        return;
+
+    ++arena.tick;
+    ++arena.stats.ticks;
+    Player& player = arena.player;
+    arena.frame.input = input;
+
+    // PLAYER MOVEMENT
+    b2Vec2 vel = b2Body_GetLinearVelocity(player.id);
+
+    if (input.left)
+    {
+        vel.x = -8.f;
+        player.dir = -1.f;
+    }
+    else if (input.right)
+    {
+        vel.x = 8.f;
+        player.dir = 1.f;
+    }
+    else
+    {
+        // slow down when no key pressed
+        vel.x *= 0.9f;
+    }
+
+    b2Vec2 pPos = b2Body_GetPosition(player.id);
+    bool grounded = isGrounded(pPos, player.radius, arena.bars);
+    if (grounded)
+        player.jumps = 2;
+
+    // jump (double jump via re-press)
+    if (input.jump && !arena.prevJump && player.jumps > 0)
+    {
+        vel.y = 12.f;
+        player.jumps--;
+        arena.events.jumped = true;
+    }
+    arena.prevJump = input.jump;
+
+    b2Body_SetLinearVelocity(player.id, vel);
+
+    // SHOOTING
+    player.shootCD -= DT;
+    if (input.shoot && player.shootCD <= 0.f)
+    {
+        shoot(arena.bullets, player, player.dir, arena.world);
+        player.shootCD = 0.25f;
+        arena.events.fired = true;
+        ++arena.stats.shots;
+    }
+    arena.frame.playerPos = pPos;
+
+    // AI can be thinned out by the governor; enemies coast in between
+    arena.frame.aiRan = arena.aiInterval <= 1 || arena.tick % arena.aiInterval == 0;
+
+    // ai -> physics -> bullets -> hits -> resolve; enemy ranges are split
+    // over every thread of the pool (one range when there is none, or when
+    // there are too few enemies to be worth it)
+    int enemyCount = (int)arena.enemies.size();
+    int grain = splitGrain(arena.pool, enemyCount);
+    JobGraph graph;
+    uint32_t ai = addJob(graph, "ai", aiJob, &arena, arena.frame.aiRan ? enemyCount : 0, grain);
+    uint32_t physics = addJob(graph, "physics", physicsJob, &arena, 1, 1, ai);
+    uint32_t bullets = addJob(graph, "bullets", bulletJob, &arena, (int)arena.bullets.size(), MAX_BULLETS, physics);
+    uint32_t hits = addJob(graph, "hits", hitJob, &arena, enemyCount, grain, bullets);
+    addJob(graph, "resolve", resolveJob, &arena, 1, 1, hits);
+    runJobGraph(arena.pool, graph);
+}
+
+// scripted player for idle server arenas and headless checks:
+// chase the nearest enemy and shoot at it
+PlayerInput botInput(const Arena& arena)
+{
+    PlayerInput in;
+    b2Vec2 p = b2Body_GetPosition(arena.player.id);
+
+    const Enemy* target = nullptr;
+    float best = 1e9f;
+    for (const auto& e : arena.enemies)
+    {
+        if (!e.alive) continue;
+        float d = b2Distance(b2Body_GetPosition(e.id), p);
+        if (d < best)
+        {
+            best = d;
+            target = &e;
+        }
+    }
+    if (!target)
+        return in;
+
+    b2Vec2 t = b2Body_GetPosition(target->id);
+    in.left = t.x < p.x - 6.f;
+    in.right = t.x > p.x + 6.f;
+    in.jump = t.y > p.y + 2.f && arena.tick % 40 == 0;
+    in.shoot = std::fabs(t.y - p.y) < 1.f;
+    return in;
+}
+
+// one seeded bot arena, contacts sampled from b2World_GetCounters each tick
+static void benchCollisions(const char* label, int enemies, int ticks)
+{
+    Arena arena;
+    setupArena(arena, 1234u, enemies);
+
+    // Box2D keeps one contact per broad-phase pair that passed the filter,
+    // touching or not, so contactCount is the pair count; begin events
+    // are the pairs the narrow phase found actually touching
+    long long pairSum = 0;
+    int pairPeak = 0;
+    long long touchSum = 0;
+    sf::Clock clock;
+    for (int i = 0; i < ticks; ++i)
+    {
+        stepArena(arena, botInput(arena));
+
+        b2Counters counters = b2World_GetCounters(arena.world);
+        pairSum += counters.contactCount;
+        pairPeak = std::max(pairPeak, counters.contactCount);
+        touchSum += b2World_GetContactEvents(arena.world).beginCount;
+
+        if (arena.gameOver || arena.playerWon)
+            resetArena(arena, arena.enemyCap, 0);
+    }
+    float ms = clock.getElapsedTime().asSeconds() * 1000.f;
+
+    std::cout << label << ": pairs avg " << (double)pairSum / ticks
+        << ", peak " << pairPeak
+        << " | touches begun " << (double)touchSum / ticks << "/tick"
+        << " | " << ms / ticks << " ms/tick\n";
+
+    destroyArena(arena);
+}
+
+int runCollisionBench(int enemies, int ticks)
+{
+    enemies = std::max(1, std::min(enemies, MAX_ARENA_ENEMIES));
+    ticks = std::max(1, ticks);
+    std::cout << "collision bench: " << enemies << " enemies, " << ticks << " ticks\n";
+
+    bool saved[CAT_COUNT][CAT_COUNT];
+    std::copy(&collisionMatrix[0][0], &collisionMatrix[0][0] + CAT_COUNT * CAT_COUNT, &saved[0][0]);
+
+    for (int a = 0; a < CAT_COUNT; ++a)
+        for (int b = 0; b < CAT_COUNT; ++b)
+            collisionMatrix[a][b] = true;
+    benchCollisions("all pairs", enemies, ticks);
+
+    std::copy(&saved[0][0], &saved[0][0] + CAT_COUNT * CAT_COUNT, &collisionMatrix[0][0]);
+    benchCollisions("filtered ", enemies, ticks);
+    return 0;
+}
+
+void destroyArena(Arena& arena)
+{
+    b2DestroyWorld(arena.world);
+    arena.world = {};
+    arena.enemies.clear();
+    arena.bullets.clear();
+}
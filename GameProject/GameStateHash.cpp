@@ -0,0 +1,372 @@
+#include "GameProject.hpp"
+#include <cstring>
+
+// xxHash64 primes and round; each lane eats one word of every 4-word block
+constexpr uint64_t HASH_P1 = 0x9E3779B185EBCA87ull;
+constexpr uint64_t HASH_P2 = 0xC2B2AE3D27D4EB4Full;
+constexpr uint64_t HASH_P3 = 0x165667B19E3779F9ull;
+
+static inline uint64_t rotl64(uint64_t x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t hashRound(uint64_t lane, uint32_t word)
+{
+    return rotl64(lane + word * HASH_P2, 31) * HASH_P1;
+}
+
+void beginStateHash(StateHash& h, uint64_t seed)
+{
+    h.lane[0] = seed + HASH_P1 + HASH_P2;
+    h.lane[1] = seed + HASH_P2;
+    h.lane[2] = seed;
+    h.lane[3] = seed - HASH_P1;
+    h.buffered = 0;
+    h.words = 0;
+}
+
+void hashWords(StateHash& h, const uint32_t* words, int count)
+{
+    h.words += (uint64_t)count;
+
+    // top up a partial block first
+    while (h.buffered > 0 && count > 0)
+    {
+        h.block[h.buffered++] = *words++;
+        --count;
+        if (h.buffered == 4)
+        {
+            for (int l = 0; l < 4; ++l)
+                h.lane[l] = hashRound(h.lane[l], h.block[l]);
+            h.buffered = 0;
+        }
+    }
+
+    // whole blocks: four independent chains, no data dependency between lanes
+    for (; count >= 4; count -= 4, words += 4)
+    {
+        h.lane[0] = hashRound(h.lane[0], words[0]);
+        h.lane[1] = hashRound(h.lane[1], words[1]);
+        h.lane[2] = hashRound(h.lane[2], words[2]);
+        h.lane[3] = hashRound(h.lane[3], words[3]);
+    }
+
+    while (count-- > 0)
+        h.block[h.buffered++] = *words++;
+}
+
+uint64_t endStateHash(StateHash& h)
+{
+    // the leftover words go into their lanes as well, so order still matters
+    for (int l = 0; l < h.buffered; ++l)
+        h.lane[l] = hashRound(h.lane[l], h.block[l]);
+
+    uint64_t x = rotl64(h.lane[0], 1) + rotl64(h.lane[1], 7) +
+        rotl64(h.lane[2], 12) + rotl64(h.lane[3], 18);
+    x += h.words;
+
+    x ^= x >> 33;
+    x *= HASH_P2;
+    x ^= x >> 29;
+    x *= HASH_P3;
+    x ^= x >> 32;
+    return x;
+}
+
+// ENTITY RECORDS: the words that get hashed, with names so a mismatch can
+// say which field moved. Floats are hashed by their bits.
+
+constexpr int MAX_ENTITY_WORDS = 16;
+
+struct EntityRecord {
+    uint32_t words[MAX_ENTITY_WORDS];
+    const char* names[MAX_ENTITY_WORDS];
+    bool isFloat[MAX_ENTITY_WORDS];
+    int count = 0;
+};
+
+static void addFloat(EntityRecord& r, const char* name, float v)
+{
+    std::memcpy(&r.words[r.count], &v, sizeof(v));
+    r.names[r.count] = name;
+    r.isFloat[r.count++] = true;
+}
+
+static void addInt(EntityRecord& r, const char* name, uint32_t v)
+{
+    r.words[r.count] = v;
+    r.names[r.count] = name;
+    r.isFloat[r.count++] = false;
+}
+
+static void addBody(EntityRecord& r, b2BodyId id)
+{
+    b2Transform xf = b2Body_GetTransform(id);
+    b2Vec2 v = b2Body_GetLinearVelocity(id);
+    addFloat(r, "pos.x", xf.p.x);
+    addFloat(r, "pos.y", xf.p.y);
+    addFloat(r, "rot.c", xf.q.c);
+    addFloat(r, "rot.s", xf.q.s);
+    addFloat(r, "vel.x", v.x);
+    addFloat(r, "vel.y", v.y);
+    addFloat(r, "angVel", b2Body_GetAngularVelocity(id));
+}
+
+static void playerRecord(const Arena& arena, EntityRecord& r)
+{
+    const Player& p = arena.player;
+    addBody(r, p.id);
+    addInt(r, "score", (uint32_t)p.score);
+    addFloat(r, "shootCD", p.shootCD);
+    addInt(r, "jumps", (uint32_t)p.jumps);
+    addFloat(r, "dir", p.dir);
+    addFloat(r, "muzzleTimer", p.muzzleTimer);
+    addInt(r, "prevJump", arena.prevJump ? 1u : 0u);
+}
+
+// dead enemies have no body left, only their AI fields
+static void enemyRecord(const Enemy& e, EntityRecord& r)
+{
+    addInt(r, "uid", e.uid);
+    addInt(r, "alive", e.alive ? 1u : 0u);
+    addFloat(r, "speed", e.speed);
+    addFloat(r, "sideBias", e.sideBias);
+    addFloat(r, "pathTimer", e.pathTimer);
+    addFloat(r, "jumpCooldown", e.jumpCooldown);
+    addInt(r, "scoreValue", (uint32_t)e.scoreValue);
+    addInt(r, "color", e.color.toInteger());
+    if (e.alive)
+        addBody(r, e.id);
+}
+
+static void bulletRecord(const Bullet& b, EntityRecord& r)
+{
+    addBody(r, b.id);
+    addFloat(r, "life", b.life);
+}
+
+static uint64_t hashRecord(const EntityRecord& r, uint64_t seed)
+{
+    StateHash h;
+    beginStateHash(h, seed);
+    hashWords(h, r.words, r.count);
+    return endStateHash(h);
+}
+
+static void hashEntityHashes(StateHash& h, const uint64_t* hashes, int count)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        uint32_t w[2] = { (uint32_t)hashes[i], (uint32_t)(hashes[i] >> 32) };
+        hashWords(h, w, 2);
+    }
+}
+
+// entity hashes first, then the world hash over them and the round state
+void hashArena(const Arena& arena, ArenaHash& out)
+{
+    out.tick = arena.tick;
+
+    EntityRecord r;
+    playerRecord(arena, r);
+    out.player = hashRecord(r, 1);
+
+    out.enemyCount = (int)arena.enemies.size();
+    for (int i = 0; i < out.enemyCount; ++i)
+    {
+        r.count = 0;
+        enemyRecord(arena.enemies[i], r);
+        out.enemies[i] = hashRecord(r, 2);
+    }
+
+    out.bulletCount = (int)arena.bullets.size();
+    for (int i = 0; i < out.bulletCount; ++i)
+    {
+        r.count = 0;
+        bulletRecord(arena.bullets[i], r);
+        out.bullets[i] = hashRecord(r, 3);
+    }
+
+    uint32_t round[6] = {
+        arena.tick,
+        arena.nextEnemyId,
+        (uint32_t)out.enemyCount,
+        (uint32_t)out.bulletCount,
+        arena.gameOver ? 1u : 0u,
+        arena.playerWon ? 1u : 0u,
+    };
+
+    StateHash h;
+    beginStateHash(h, arena.seed);
+    hashWords(h, round, 6);
+    hashEntityHashes(h, &out.player, 1);
+    hashEntityHashes(h, out.enemies, out.enemyCount);
+    hashEntityHashes(h, out.bullets, out.bulletCount);
+    out.world = endStateHash(h);
+}
+
+// DIVERGENCE TOOL
+
+static void printFieldDiff(const EntityRecord& a, const EntityRecord& b)
+{
+    int n = std::min(a.count, b.count);
+    for (int i = 0; i < n; ++i)
+    {
+        if (a.words[i] == b.words[i])
+            continue;
+
+        if (a.isFloat[i])
+        {
+            float fa, fb;
+            std::memcpy(&fa, &a.words[i], sizeof(fa));
+            std::memcpy(&fb, &b.words[i], sizeof(fb));
+            std::printf("    %-12s %.9g vs %.9g (diff %.3g)\n", a.names[i], fa, fb, fb - fa);
+        }
+        else
+        {
+            std::printf("    %-12s %u vs %u\n", a.names[i], a.words[i], b.words[i]);
+        }
+    }
+    if (a.count != b.count)
+        std::printf("    (%d fields vs %d)\n", a.count, b.count);
+}
+
+// first entity whose hash differs, with the fields that differ
+static void reportDivergence(const Arena& a, const ArenaHash& ha, const Arena& b, const ArenaHash& hb)
+{
+    std::printf("first divergence at tick %u (world %016llx vs %016llx)\n", ha.tick,
+        (unsigned long long)ha.world, (unsigned long long)hb.world);
+
+    EntityRecord ra, rb;
+    if (ha.player != hb.player)
+    {
+        std::printf("  player\n");
+        playerRecord(a, ra);
+        playerRecord(b, rb);
+        printFieldDiff(ra, rb);
+        return;
+    }
+
+    int enemies = std::min(ha.enemyCount, hb.enemyCount);
+    for (int i = 0; i < enemies; ++i)
+    {
+        if (ha.enemies[i] == hb.enemies[i])
+            continue;
+        std::printf("  enemy uid %u (slot %d)\n", a.enemies[i].uid, i);
+        enemyRecord(a.enemies[i], ra);
+        enemyRecord(b.enemies[i], rb);
+        printFieldDiff(ra, rb);
+        return;
+    }
+
+    int bullets = std::min(ha.bulletCount, hb.bulletCount);
+    for (int i = 0; i < bullets; ++i)
+    {
+        if (ha.bullets[i] == hb.bullets[i])
+            continue;
+        std::printf("  bullet %d\n", i);
+        bulletRecord(a.bullets[i], ra);
+        bulletRecord(b.bullets[i], rb);
+        printFieldDiff(ra, rb);
+        return;
+    }
+
+    // every shared entity matches: the difference is in the round state
+    std::printf("  round state: enemies %d vs %d, bullets %d vs %d, next id %u vs %u, over %d vs %d, won %d vs %d\n",
+        ha.enemyCount, hb.enemyCount, ha.bulletCount, hb.bulletCount,
+        a.nextEnemyId, b.nextEnemyId, (int)a.gameOver, (int)b.gameOver,
+        (int)a.playerWon, (int)b.playerWon);
+}
+
+int runDivergence(const char* variant, int ticks, int threads, int enemies)
+{
+    ticks = std::max(1, ticks);
+    threads = std::max(1, threads);
+    enemies = std::max(1, std::min(enemies, MAX_ARENA_ENEMIES));
+
+    bool usePool = std::strcmp(variant, "threads") == 0;
+    if (usePool && threads < 2)
+    {
+        std::cout << "The threads variant needs at least 2 threads\n";
+        return 2;
+    }
+
+    const unsigned seed = 1234u;
+    Arena a, b;
+    setupArena(a, seed, enemies);
+    setupArena(b, seed, enemies);
+
+    WorkerPool pool;
+    if (usePool)
+    {
+        startWorkerPool(pool, threads);
+        b.pool = &pool;
+    }
+    else if (std::strcmp(variant, "substeps") == 0)
+        b.subSteps = SUB_STEPS - 1;
+    else if (std::strcmp(variant, "ai") == 0)
+        b.aiInterval = 2;
+    else if (std::strcmp(variant, "repeat") != 0)
+    {
+        std::cout << "Unknown variant " << variant << " (threads, repeat, substeps, ai)\n";
+        destroyArena(a);
+        destroyArena(b);
+        return 2;
+    }
+
+    std::cout << "diverge: reference vs " << variant;
+    if (usePool)
+        std::cout << " (" << threads << " threads)";
+    std::cout << ", " << enemies << " enemies, " << ticks << " ticks\n";
+
+    ArenaHash ha, hb;
+    double hashMs = 0.0;
+    int diverged = -1;
+    for (int i = 0; i < ticks; ++i)
+    {
+        // both get the reference's input, so only the stepping differs
+        PlayerInput input = botInput(a);
+        stepArena(a, input);
+        stepArena(b, input);
+
+        sf::Clock clock;
+        hashArena(a, ha);
+        hashArena(b, hb);
+        hashMs += clock.getElapsedTime().asMicroseconds() / 1000.0;
+
+        if (ha.world != hb.world)
+        {
+            reportDivergence(a, ha, b, hb);
+            diverged = i;
+            break;
+        }
+
+        if (a.gameOver || a.playerWon)
+        {
+            resetArena(a, a.enemyCap, 0);
+            resetArena(b, b.enemyCap, 0);
+        }
+    }
+
+    int hashed = diverged >= 0 ? diverged + 1 : ticks;
+    if (diverged < 0)
+        std::printf("identical for %d ticks (last world hash %016llx)\n",
+            ticks, (unsigned long long)ha.world);
+    std::printf("hashing: %.4f ms per arena per tick\n", hashMs / (2.0 * hashed));
+
+    // a variant that never left the calling thread compared nothing
+    bool pooled = true;
+    if (usePool)
+    {
+        std::printf("waves run on the pool: %llu\n", (unsigned long long)pool.pooledRuns);
+        pooled = pool.pooledRuns > 0;
+        if (!pooled)
+            std::cout << "No wave reached a worker, so thread independence was not tested"
+                " (enemy ranges split from " << 2 * MIN_SPLIT_GRAIN << " enemies up)\n";
+        stopWorkerPool(pool);
+    }
+    destroyArena(a);
+    destroyArena(b);
+    return diverged >= 0 || !pooled ? 1 : 0;
+}
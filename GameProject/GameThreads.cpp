@@ -0,0 +1,183 @@
+#include "GameProject.hpp"
+
+// grab chunks until the range is used up
+static void runChunks(WorkerPool& pool)
+{
+    for (;;)
+    {
+        int begin = pool.next.fetch_add(pool.grain);
+        if (begin >= pool.count)
+            break;
+        int end = std::min(begin + pool.grain, pool.count);
+        pool.fn(pool.ctx, begin, end);
+    }
+}
+
+static void workerLoop(WorkerPool* pool)
+{
+    uint64_t seen = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(pool->m);
+            // only as many workers as there are spare chunks get to join
+            pool->wake.wait(lock, [&] { return pool->quit || (pool->generation != seen && pool->slots > 0); });
+            if (pool->quit)
+                return;
+            seen = pool->generation;
+            --pool->slots;
+        }
+
+        runChunks(*pool);
+
+        std::lock_guard<std::mutex> lock(pool->m);
+        if (--pool->busy == 0)
+            pool->done.notify_one();
+    }
+}
+
+// threadCount includes the caller, so 1 means "no extra threads"
+void startWorkerPool(WorkerPool& pool, int threadCount)
+{
+    pool.quit = false;
+    for (int i = 1; i < threadCount; ++i)
+        pool.threads.emplace_back(workerLoop, &pool);
+}
+
+void stopWorkerPool(WorkerPool& pool)
+{
+    {
+        std::lock_guard<std::mutex> lock(pool.m);
+        pool.quit = true;
+    }
+    pool.wake.notify_all();
+    for (auto& t : pool.threads)
+        t.join();
+    pool.threads.clear();
+}
+
+// runs fn over [0, count) in chunks of grain, returns when all are done
+void parallelFor(WorkerPool& pool, int count, int grain, TaskFn fn, void* ctx)
+{
+    if (count <= 0)
+        return;
+    grain = std::max(1, grain);
+
+    if (pool.threads.empty() || count <= grain)
+    {
+        fn(ctx, 0, count);
+        return;
+    }
+
+    // the caller takes a chunk too, so wake at most one worker per other chunk
+    int chunks = (count + grain - 1) / grain;
+    int helpers = std::min((int)pool.threads.size(), chunks - 1);
+    {
+        std::lock_guard<std::mutex> lock(pool.m);
+        pool.fn = fn;
+        pool.ctx = ctx;
+        pool.count = count;
+        pool.grain = grain;
+        pool.next = 0;
+        pool.busy = helpers;
+        pool.slots = helpers;
+        ++pool.generation;
+        ++pool.pooledRuns;
+    }
+    for (int i = 0; i < helpers; ++i)
+        pool.wake.notify_one();
+
+    runChunks(pool);
+
+    std::unique_lock<std::mutex> lock(pool.m);
+    pool.done.wait(lock, [&] { return pool.busy == 0; });
+}
+
+int splitGrain(const WorkerPool* pool, int count)
+{
+    int threads = pool ? (int)pool->threads.size() + 1 : 1;
+    return std::max(MIN_SPLIT_GRAIN, (count + threads - 1) / threads);
+}
+
+uint32_t addJob(JobGraph& graph, const char* name, TaskFn fn, void* ctx,
+    int count, int grain, uint32_t deps)
+{
+    Job job;
+    job.name = name;
+    job.fn = fn;
+    job.ctx = ctx;
+    job.count = count;
+    job.grain = std::max(1, grain);
+    job.deps = deps;
+
+    if (!graph.jobs.push_back(job))
+    {
+        std::cout << "Job graph full, dropping " << name << "\n";
+        return 0;
+    }
+    return 1u << (graph.jobs.size() - 1);
+}
+
+// the jobs that are ready together, flattened into one chunk range
+struct JobWave {
+    const Job* jobs[MAX_JOBS];
+    int firstChunk[MAX_JOBS + 1];
+    int jobCount = 0;
+};
+
+static void runWaveChunks(void* ctx, int begin, int end)
+{
+    const JobWave& wave = *static_cast<const JobWave*>(ctx);
+    int j = 0;
+    for (int c = begin; c < end; ++c)
+    {
+        while (c >= wave.firstChunk[j + 1])
+            ++j;
+        const Job& job = *wave.jobs[j];
+        int first = (c - wave.firstChunk[j]) * job.grain;
+        job.fn(job.ctx, first, std::min(first + job.grain, job.count));
+    }
+}
+
+// Runs wave after wave until every job is done. Jobs only ever see their
+// own ranges, so results do not depend on how many threads the pool has.
+void runJobGraph(WorkerPool* pool, const JobGraph& graph)
+{
+    const int n = (int)graph.jobs.size();
+    const uint32_t all = n == 32 ? ~0u : (1u << n) - 1u;
+    uint32_t done = 0;
+
+    while (done != all)
+    {
+        JobWave wave;
+        wave.firstChunk[0] = 0;
+        uint32_t ready = 0;
+        for (int i = 0; i < n; ++i)
+        {
+            const Job& job = graph.jobs[i];
+            uint32_t bit = 1u << i;
+            if ((done & bit) || (job.deps & ~done))
+                continue;
+
+            ready |= bit;
+            wave.jobs[wave.jobCount] = &job;
+            int chunks = (std::max(0, job.count) + job.grain - 1) / job.grain;
+            wave.firstChunk[wave.jobCount + 1] = wave.firstChunk[wave.jobCount] + chunks;
+            ++wave.jobCount;
+        }
+
+        if (ready == 0)
+        {
+            std::cout << "Job graph has a dependency cycle\n";
+            return;
+        }
+
+        int chunks = wave.firstChunk[wave.jobCount];
+        if (pool)
+            parallelFor(*pool, chunks, 1, runWaveChunks, &wave);
+        else
+            runWaveChunks(&wave, 0, chunks);
+
+        done |= ready;
+    }
+}
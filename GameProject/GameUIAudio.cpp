@@ -1,33 +1,32 @@
 #include "GameProject.hpp"
 
 // Text and font
-void setupText(sf::Font& font,
+void setupText(const sf::Font& font,
     sf::Text& scoreText,
     sf::Text& title,
     sf::Text& controls,
     sf::Text& msgText,
-    const sf::RenderWindow& window)
+    const Layout& ui)
 {
-    font.loadFromFile("C:\\Windows\\Fonts\\arial.ttf");
+    // sizes are logical; glyphs are rasterized at the real window scale
+    auto size = [&](float logical) { return (unsigned)std::lround(logical * ui.scale); };
 
     scoreText.setFont(font);
-    scoreText.setString("Score: 0");
-    scoreText.setCharacterSize(32);
+    scoreText.setString("Score: ");
+    scoreText.setCharacterSize(size(32));
     scoreText.setFillColor(sf::Color::White);
     scoreText.setOutlineColor(sf::Color::Black);
-    scoreText.setOutlineThickness(2);
-    scoreText.setPosition(30.f, 20.f);
+    scoreText.setOutlineThickness(2 * ui.scale);
+    scoreText.setPosition(toScreen(ui, { 30.f, 20.f }));
 
     title.setFont(font);
     title.setString("BATTLE BOX SHOOTER");
-    title.setCharacterSize(110);
+    title.setCharacterSize(size(110));
     title.setFillColor(sf::Color(0, 255, 180));
     title.setOutlineColor(sf::Color::Black);
-    title.setOutlineThickness(6);
-    title.setPosition(
-        window.getSize().x / 2.f - 580.f,
-        window.getSize().y / 3.f - 150.f
-    );
+    title.setOutlineThickness(6 * ui.scale);
+    centerTextX(title);
+    title.setPosition(toScreen(ui, { LOGICAL_W / 2.f, LOGICAL_H / 3.f - 150.f }));
 
     controls.setFont(font);
     controls.setString(
@@ -35,51 +34,119 @@ void setupText(sf::Font& font,
         "RIGHT Arrow - Move Right   S - Shoot\n"
         "R - Restart                ENTER - Start"
     );
-    controls.setCharacterSize(45);
+    controls.setCharacterSize(size(45));
     controls.setFillColor(sf::Color::White);
     controls.setOutlineColor(sf::Color::Black);
-    controls.setOutlineThickness(3);
-    controls.setPosition(
-        window.getSize().x / 2.f - 550.f,
-        window.getSize().y / 2.f
-    );
+    controls.setOutlineThickness(3 * ui.scale);
+    centerTextX(controls);
+    controls.setPosition(toScreen(ui, { LOGICAL_W / 2.f, LOGICAL_H / 2.f }));
 
     msgText.setFont(font);
     msgText.setString("");
-    msgText.setCharacterSize(40);
+    msgText.setCharacterSize(size(40));
     msgText.setOutlineColor(sf::Color::Black);
-    msgText.setOutlineThickness(3);
+    msgText.setOutlineThickness(3 * ui.scale);
+}
+
+void centerTextX(sf::Text& text)
+{
+    sf::FloatRect b = text.getLocalBounds();
+    text.setOrigin(std::round(b.left + b.width / 2.f), 0.f);
 }
 
 // Audio  identical to your last version (with jump + looping game-start)
 void setupAudio(sf::SoundBuffer& fireBuffer,
     sf::SoundBuffer& enemyDeadBuffer,
-    sf::SoundBuffer& gameStartBuffer,
     sf::SoundBuffer& lossBuffer,
     sf::SoundBuffer& jumpBuffer,
     sf::Sound& fireSound,
     sf::Sound& enemyDeadSound,
-    sf::Sound& gameStartSound,
     sf::Sound& lossSound,
-    sf::Sound& jumpSound)
+    sf::Sound& jumpSound,
+    sf::Music& gameStartMusic,
+    const AssetArchive& assets)
 {
-    if (!fireBuffer.loadFromFile("fire.wav"))
+    sf::Clock loadClock;
+
+    // short, hot effects: decoded once, replayed from memory
+    if (!loadAsset(fireBuffer, assets, "fire.wav"))
         std::cout << "Failed to load fire.wav\n";
-    if (!enemyDeadBuffer.loadFromFile("enemy-dead.wav"))
+    if (!loadAsset(enemyDeadBuffer, assets, "enemy-dead.wav"))
         std::cout << "Failed to load enemy-dead.wav\n";
-    if (!gameStartBuffer.loadFromFile("game-start.wav"))
-        std::cout << "Failed to load game-start.wav\n";
-    if (!lossBuffer.loadFromFile("loss.wav"))
+    if (!loadAsset(lossBuffer, assets, "loss.wav"))
         std::cout << "Failed to load loss.wav\n";
-    if (!jumpBuffer.loadFromFile("jump.wav"))
+    if (!loadAsset(jumpBuffer, assets, "jump.wav"))
         std::cout << "Failed to load jump.wav\n";
 
     fireSound.setBuffer(fireBuffer);
     enemyDeadSound.setBuffer(enemyDeadBuffer);
-    gameStartSound.setBuffer(gameStartBuffer);
     lossSound.setBuffer(lossBuffer);
     jumpSound.setBuffer(jumpBuffer);
 
+    // background track: streamed in small chunks, compressed formats first
+    // when present. None of these are in the repository; like the effects,
+    // the track is supplied next to the executable or in assets.pak
+    bool musicOpen = false;
+    for (const char* name : { "game-start.ogg", "game-start.flac", "game-start.wav" })
+    {
+        if (hasAsset(assets, name) && openAsset(gameStartMusic, assets, name))
+        {
+            musicOpen = true;
+            break;
+        }
+    }
+    if (!musicOpen)
+        std::cout << "Failed to load game-start (.ogg/.flac/.wav)\n";
+
     // Game start should always loop
-    gameStartSound.setLoop(true);
+    gameStartMusic.setLoop(true);
+
+    // resident memory report; the music figure is an estimate from its
+    // duration, since a stream never holds the whole track
+    auto decodedBytes = [](const sf::SoundBuffer& b)
+        {
+            return (unsigned long long)b.getSampleCount() * sizeof(sf::Int16);
+        };
+    unsigned long long effects = decodedBytes(fireBuffer) + decodedBytes(enemyDeadBuffer) +
+        decodedBytes(lossBuffer) + decodedBytes(jumpBuffer);
+    unsigned long long musicDecoded = musicOpen
+        ? (unsigned long long)(gameStartMusic.getDuration().asSeconds() *
+            gameStartMusic.getSampleRate() * gameStartMusic.getChannelCount()) * sizeof(sf::Int16)
+        : 0;
+
+    std::cout << "Audio loaded in " << loadClock.getElapsedTime().asMilliseconds() << " ms, resident "
+        << effects / 1024 << " KB (about " << (effects + musicDecoded) / 1024
+        << " KB if the music were fully decoded)\n";
+}
+
+// Number digits (glyph geometry is built once here, never per frame)
+void setupNumberText(NumberText& number, const sf::Font& font, const sf::Text& style)
+{
+    const char glyphs[] = "0123456789-";
+    for (int i = 0; i < 11; ++i)
+    {
+        number.digits[i] = style;
+        number.digits[i].setFont(font);
+        number.digits[i].setString(std::string(1, glyphs[i]));
+    }
+
+    // Arial digits all share one advance
+    number.advance = font.getGlyph('0', style.getCharacterSize(), false).advance;
+}
+
+void drawNumber(sf::RenderTarget& target, NumberText& number, const char* text, sf::Vector2f pos,
+    RenderStats* stats)
+{
+    for (const char* c = text; *c; ++c)
+    {
+        int index = (*c == '-') ? 10 : *c - '0';
+        if (index < 0 || index > 10) continue;
+
+        number.digits[index].setPosition(pos);
+        if (stats)
+            statDraw(*stats, DrawCategory::HUD, target, number.digits[index]);
+        else
+            target.draw(number.digits[index]);
+        pos.x += number.advance;
+    }
 }
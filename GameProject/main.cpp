@@ -0,0 +1,58 @@
+#include "GameProject.hpp"
+#include <cstring>
+#include <cstdlib>
+
+// GameProject.exe [--autosave seconds]                     normal game
+// GameProject.exe --server [port] [arenas] [threads] [enemies]
+// GameProject.exe --connect [host] [port]
+// GameProject.exe --batch-bench [envs] [threads] [steps]
+// GameProject.exe --alloc-check [frames]
+// GameProject.exe --collision-bench [enemies] [ticks]
+// GameProject.exe --diverge [threads|repeat|substeps|ai] [ticks] [threads] [enemies]
+// GameProject.exe --pack out.pak file...
+// GameProject.exe --leaderboard
+// GameProject.exe --history [player]
+int main(int argc, char** argv)
+{
+    auto intArg = [&](int i, int fallback)
+        {
+            return i < argc ? std::atoi(argv[i]) : fallback;
+        };
+    int cores = std::max(1, (int)std::thread::hardware_concurrency());
+    countBox2DAllocations();
+
+    if (argc > 1 && std::strcmp(argv[1], "--server") == 0)
+        return runServer((unsigned short)intArg(2, NET_PORT), intArg(3, 64),
+            intArg(4, cores), intArg(5, MAX_ENEMIES));
+
+    if (argc > 1 && std::strcmp(argv[1], "--connect") == 0)
+        return runNetClient(argc > 2 ? argv[2] : "127.0.0.1",
+            (unsigned short)intArg(3, NET_PORT));
+
+    if (argc > 1 && std::strcmp(argv[1], "--batch-bench") == 0)
+        return runBatchBench(intArg(2, 256), intArg(3, cores), intArg(4, 1000));
+
+    if (argc > 1 && std::strcmp(argv[1], "--alloc-check") == 0)
+        return runAllocCheck(intArg(2, 3600));
+
+    if (argc > 1 && std::strcmp(argv[1], "--collision-bench") == 0)
+        return runCollisionBench(intArg(2, MAX_ARENA_ENEMIES), intArg(3, 3600));
+
+    if (argc > 1 && std::strcmp(argv[1], "--diverge") == 0)
+        return runDivergence(argc > 2 ? argv[2] : "threads", intArg(3, 3600), intArg(4, cores),
+            intArg(5, MAX_ARENA_ENEMIES));
+
+    if (argc > 1 && std::strcmp(argv[1], "--leaderboard") == 0)
+        return runLeaderboard();
+
+    if (argc > 1 && std::strcmp(argv[1], "--history") == 0)
+        return runHistory(argc > 2 ? argv[2] : nullptr);
+
+    if (argc > 2 && std::strcmp(argv[1], "--pack") == 0)
+        return runPacker(argv[2], argc - 3, argv + 3);
+
+    if (argc > 1 && std::strcmp(argv[1], "--autosave") == 0)
+        return runGame(argc > 2 ? (float)std::atof(argv[2]) : AUTOSAVE_SECONDS);
+
+    return runGame();
+}